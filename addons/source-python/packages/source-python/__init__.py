@@ -73,6 +73,8 @@ if LOG_FILE_OPERATIONS:
 from contextlib import suppress
 
 # Source.Python Imports
+#   Core
+from core.profiler import startup_profiler
 #   Loggers
 from loggers import _sp_logger  # It's save to import this here
 
@@ -82,20 +84,24 @@ from loggers import _sp_logger  # It's save to import this here
 # =============================================================================
 def load():
     """Load Source.Python's Python side."""
-    setup_stdout_redirect()
-    setup_core_settings()
-    setup_logging()
-    setup_exception_hooks()
-    setup_data_update()
-    setup_translations()
-    setup_data()
-    setup_global_pointers()
-    setup_sp_command()
-    setup_auth()
-    setup_user_settings()
-    setup_entities_listener()
-    setup_versioning()
-    setup_sqlite()
+    for setup in (
+            setup_lazy_packages,
+            setup_stdout_redirect,
+            setup_core_settings,
+            setup_logging,
+            setup_exception_hooks,
+            setup_data_update,
+            setup_translations,
+            setup_data,
+            setup_global_pointers,
+            setup_sp_command,
+            setup_auth,
+            setup_user_settings,
+            setup_entities_listener,
+            setup_versioning,
+            setup_sqlite):
+        with startup_profiler.section(setup.__name__):
+            setup()
 
 
 def unload():
@@ -103,6 +109,21 @@ def unload():
     unload_plugins()
     remove_entities_listener()
     unload_auth()
+    unload_user_settings()
+    unload_sound_info()
+    unload_metrics()
+    unload_tick_collector()
+
+
+# =============================================================================
+# >> LAZY PACKAGES
+# =============================================================================
+def setup_lazy_packages():
+    """Import submodules of Source.Python's packages on first access."""
+    _sp_logger.log_debug('Setting up lazy packages...')
+
+    from core import _LazyPackageFinder
+    _LazyPackageFinder.install()
 
 
 # =============================================================================
@@ -144,14 +165,14 @@ def setup_data():
     """Setup data."""
     _sp_logger.log_debug('Setting up data...')
 
-    from core import GameConfigObj
+    from core import get_game_data
     from memory.manager import manager
     from paths import SP_DATA_PATH
 
     import players
     players.BaseClient = manager.create_type_from_dict(
         'BaseClient',
-        GameConfigObj(SP_DATA_PATH / 'client' / 'CBaseClient.ini'))
+        get_game_data(SP_DATA_PATH / 'client' / 'CBaseClient.ini'))
 
     from core.cache import CachedProperty
     from memory import get_function_info
@@ -174,13 +195,15 @@ def setup_data():
     import entities
     entities._BaseEntityOutput = manager.create_type_from_dict(
         'BaseEntityOutput',
-        GameConfigObj(SP_DATA_PATH / 'entity_output' / 'CBaseEntityOutput.ini'))
+        get_game_data(SP_DATA_PATH / 'entity_output' / 'CBaseEntityOutput.ini'))
 
     from _entities import BaseEntityOutput
+    from _entities._outputs import entity_output_registry
     try:
         _fire_output = entities._BaseEntityOutput.fire_output
 
         BaseEntityOutput.fire_output = _fire_output
+        entity_output_registry.function = _fire_output
     except ValueError:
         from warnings import warn
         warn(
@@ -204,8 +227,32 @@ def setup_core_settings():
     """Setup core settings."""
     _sp_logger.log_debug('Setting up core settings...')
 
+    from core import _game_data_cache
+    from core.profiler import frame_budget
     from core.settings import _core_settings
     _core_settings.load()
+    _game_data_cache.enabled = _core_settings.game_data_cache
+
+    if _core_settings.tick_budget > 0:
+        frame_budget.threshold = _core_settings.tick_budget
+        frame_budget.enabled = True
+
+    # Importing core.metrics also starts recording garbage collections
+    from core.metrics import metrics
+    from hooks.exceptions import except_hooks
+    try:
+        if _core_settings.metrics_shm:
+            metrics.open_shared_memory(_core_settings.metrics_shm)
+
+        if _core_settings.metrics_socket:
+            metrics.listen(_core_settings.metrics_socket)
+    except RuntimeError:
+        except_hooks.print_exception()
+
+    if 0 < _core_settings.gc_tick_budget <= 100:
+        from core.collector import tick_collector
+        tick_collector.budget = _core_settings.gc_tick_budget
+        tick_collector.enabled = True
 
 
 # =============================================================================
@@ -303,12 +350,11 @@ def setup_global_pointers():
 
     import sys
     from warnings import warn
-    from core import GameConfigObj
     from memory.manager import manager
     from paths import SP_DATA_PATH
 
-    manager.create_global_pointers_from_file(GameConfigObj(
-        SP_DATA_PATH / 'memory' / 'global_pointers.ini'))
+    manager.create_global_pointers_from_file(
+        SP_DATA_PATH / 'memory' / 'global_pointers.ini')
 
     _sp_logger.log_debug('Setting up global "server" variables...')
     from engines import server
@@ -343,7 +389,8 @@ def setup_sp_command():
     """Set up the 'sp' command."""
     _sp_logger.log_debug('Setting up the "sp" command...')
 
-    from core.command import auth, docs, dump, plugin
+    from core.command import (
+        auth, collector, docs, dump, metrics, plugin, profile)
 
 
 # =============================================================================
@@ -401,6 +448,63 @@ def setup_user_settings():
             ','), _player_settings._send_menu)
 
 
+def unload_user_settings():
+    """Write all pending user settings and stop the writer thread."""
+    _sp_logger.log_debug('Unloading user settings...')
+
+    from settings.storage import _player_settings_storage
+    _player_settings_storage.unload()
+
+
+# =============================================================================
+# >> SOUND INFO
+# =============================================================================
+def unload_sound_info():
+    """Stop the sound info thread and store the index."""
+    import sys
+
+    # Nothing to store if no sound has been used
+    if 'engines.sound' not in sys.modules:
+        return
+
+    _sp_logger.log_debug('Unloading sound info...')
+
+    from engines.sound import SOUND_INFO_INDEX_PATH
+    from engines.sound import sound_info_index
+    sound_info_index.shutdown()
+
+    if not sound_info_index.modified:
+        return
+
+    if not SOUND_INFO_INDEX_PATH.parent.isdir():
+        SOUND_INFO_INDEX_PATH.parent.makedirs()
+
+    sound_info_index.save(SOUND_INFO_INDEX_PATH)
+
+
+# =============================================================================
+# >> METRICS
+# =============================================================================
+def unload_metrics():
+    """Stop publishing the metrics."""
+    _sp_logger.log_debug('Unloading metrics...')
+
+    from _core._metrics import metrics
+    metrics.close_socket()
+    metrics.close_shared_memory()
+
+
+# =============================================================================
+# >> GARBAGE COLLECTION
+# =============================================================================
+def unload_tick_collector():
+    """Let Python run garbage collections automatically again."""
+    _sp_logger.log_debug('Unloading tick collector...')
+
+    from _core._collector import tick_collector
+    tick_collector.enabled = False
+
+
 # =============================================================================
 # >> ENTITIES LISTENER
 # =============================================================================
@@ -9,11 +9,15 @@
 #   Thread
 from contextlib import contextmanager
 from threading import Thread
+#   Time
+import time
 
 # Source.Python Imports
 #   Auth
 from auth.base import Backend
 from auth.manager import auth_manager
+from auth.manager import ParentPermissionDict
+from auth.manager import PlayerPermissionDict
 from auth.manager import PlayerPermissions
 from auth.manager import ParentPermissions
 #   Paths
@@ -24,6 +28,7 @@ from listeners.tick import GameThread
 # Site-Packges Imports
 #   SQL Alechemy
 from sqlalchemy import Column
+from sqlalchemy import Float
 from sqlalchemy import String
 from sqlalchemy import Integer
 from sqlalchemy import ForeignKey
@@ -31,6 +36,7 @@ from sqlalchemy import Enum
 from sqlalchemy import create_engine
 from sqlalchemy import Table
 from sqlalchemy import UniqueConstraint
+from sqlalchemy import func
 from sqlalchemy.orm import relationship
 from sqlalchemy.orm import sessionmaker
 from sqlalchemy.exc import IntegrityError
@@ -48,6 +54,19 @@ __all__ = ('SQLBackend',
 # =============================================================================
 # >> GLOBAL VARIABLES
 # =============================================================================
+# Seconds a missing change ID is looked up again. IDs are reserved before a
+# transaction commits, so a change can become visible after changes with
+# higher IDs. IDs of transactions that have been rolled back never appear.
+CHANGE_GAP_TIMEOUT = 300
+
+# Number of change IDs below the revision that are checked for gaps after
+# all objects have been loaded
+CHANGE_GAP_WINDOW = 100
+
+# Seconds changes are kept. Servers that haven't synchronized for longer
+# load all objects again.
+CHANGE_RETENTION = 60 * 60 * 24 * 7
+
 Base = declarative_base()
 Session = sessionmaker()
 parents_table = Table(
@@ -117,9 +136,31 @@ class PermissionObject(Base):
     )
 
 
+class Change(Base):
+    """A log entry of a single modification.
+
+    The IDs are monotonic, so every server only needs to apply the changes
+    that have been added since its last synchronization and the changes
+    whose IDs were missing so far.
+    """
+    __tablename__ = 'changes'
+
+    id = Column(Integer, primary_key=True)
+    type = Column(Enum('Parent', 'Player'), name='object_type',
+        nullable=False)
+    identifier = Column(String(64), nullable=False)
+    action = Column(Enum('permission_added', 'permission_removed',
+        'parent_added', 'parent_removed'), name='change_action',
+        nullable=False)
+    value = Column(String(255), nullable=False)
+    server_id = Column(Integer, default=-1, nullable=False)
+    created = Column(Float, default=time.time, nullable=False, index=True)
+
+
 class LoadThread(GameThread):
-    def __init__(self):
+    def __init__(self, backend):
         super().__init__()
+        self.backend = backend
         self._running = True
 
     def stop(self):
@@ -127,30 +168,102 @@ class LoadThread(GameThread):
 
     def run(self):
         with session_scope() as session:
-            try:
-                query = session.query(PermissionObject).all()
-            except:
-                raise
+            now = time.time()
+            if (self.backend.revision is None or
+                    now - self.backend.synchronized > CHANGE_RETENTION):
+                self._load_all(session)
             else:
-                # Only clear the manager if the query finished without any
-                # errors
-                auth_manager.parents.clear()
-                auth_manager.players.clear()
-
-            for node in query:
-                if not self._running:
-                    break
-
-                if node.type == 'Parent':
-                    store = auth_manager.parents[node.identifier]
-                else:
-                    store = auth_manager.players[node.identifier]
-
-                for permission in node.permissions:
-                    store.add(permission.node, update_backend=False)
+                self._load_changes(session)
+
+            if self._running:
+                self.backend.synchronized = now
+                session.query(Change).filter(
+                    Change.created < now - CHANGE_RETENTION).delete(False)
+
+    def _load_all(self, session):
+        """Load all objects into new storages and replace the current ones.
+
+        The current storages stay untouched until all objects have been
+        loaded, so permissions are never missing while loading.
+        """
+        # Get the revision before the objects, so changes that are added in
+        # the meantime will be applied again with the next synchronization
+        revision = session.query(func.max(Change.id)).scalar() or 0
+        query = session.query(PermissionObject).all()
+
+        parents = ParentPermissionDict()
+        players = PlayerPermissionDict(parents)
+        for node in query:
+            if not self._running:
+                return
+
+            if node.type == 'Parent':
+                store = parents[node.identifier]
+            else:
+                store = players[node.identifier]
+
+            for permission in node.permissions:
+                store.add(
+                    permission.node, permission.server_id,
+                    update_backend=False)
+
+            for parent in node.parents:
+                store.add_parent(parent.identifier, update_backend=False)
+
+        # Changes that were still being committed might not be included
+        existing = set(change_id for change_id, in session.query(
+            Change.id).filter(Change.id > revision - CHANGE_GAP_WINDOW))
+        now = time.time()
+
+        auth_manager.replace_permissions(parents, players)
+        self.backend.revision = revision
+        self.backend.gaps = {
+            change_id: now for change_id in range(
+                max(1, revision - CHANGE_GAP_WINDOW + 1), revision + 1)
+            if change_id not in existing}
+
+    def _load_changes(self, session):
+        """Apply all changes since the last synchronization."""
+        backend = self.backend
+        now = time.time()
+        for change_id, noticed in tuple(backend.gaps.items()):
+            if now - noticed > CHANGE_GAP_TIMEOUT:
+                del backend.gaps[change_id]
+
+        condition = Change.id > backend.revision
+        if backend.gaps:
+            condition |= Change.id.in_(tuple(backend.gaps))
+
+        query = session.query(Change).filter(condition).order_by(Change.id)
+        for change in query:
+            if not self._running:
+                break
+
+            # Remember the IDs that have been skipped, because their
+            # transactions might not have been committed yet
+            if change.id > backend.revision:
+                for change_id in range(backend.revision + 1, change.id):
+                    backend.gaps[change_id] = now
+
+                backend.revision = change.id
+            else:
+                del backend.gaps[change.id]
 
-                for parent in node.parents:
-                    store.add_parent(parent.identifier, update_backend=False)
+            if change.type == 'Parent':
+                store = auth_manager.parents[change.identifier]
+            else:
+                store = auth_manager.players[change.identifier]
+
+            if change.action == 'permission_added':
+                store.add(
+                    change.value, change.server_id, update_backend=False)
+            elif change.action == 'permission_removed':
+                store.remove(
+                    change.value, change.server_id, update_backend=False)
+            elif change.action == 'parent_added':
+                store.add_parent(change.value, update_backend=False)
+            else:
+                store.remove_parent(change.value, update_backend=False)
 
 
 class SQLBackend(Backend):
@@ -163,6 +276,17 @@ class SQLBackend(Backend):
         self.engine = None
         self.thread = None
 
+        # ID of the last change that has been applied. If None, all objects
+        # will be loaded with the next synchronization.
+        self.revision = None
+
+        # Change IDs below the revision that haven't been seen yet and the
+        # time they have been noticed
+        self.gaps = {}
+
+        # Time of the last synchronization
+        self.synchronized = 0
+
     def load(self):
         self.engine = create_engine(self.options['uri'])
         Base.metadata.create_all(self.engine)
@@ -171,13 +295,14 @@ class SQLBackend(Backend):
 
     def unload(self):
         self.stop_sync()
+        self.revision = None
 
     def sync(self):
         self.stop_sync()
         self.start_sync()
 
     def start_sync(self):
-        self.thread = LoadThread()
+        self.thread = LoadThread(self)
         self.thread.start()
 
     def stop_sync(self):
@@ -197,6 +322,8 @@ class SQLBackend(Backend):
                     node=permission
                 )
                 session.add(instance)
+                self.add_change(session, node_type, identifier,
+                    'permission_added', permission, server_id)
         except IntegrityError:
             pass
 
@@ -211,6 +338,8 @@ class SQLBackend(Backend):
                 server_id=server_id,
                 node=permission
             ).delete(False)
+            self.add_change(session, node_type, identifier,
+                'permission_removed', permission, server_id)
 
     def parent_added(self, node, parent_name):
         try:
@@ -226,6 +355,8 @@ class SQLBackend(Backend):
                     parent_id=parent.id,
                     child_id=child.id)
                 session.execute(parent_insert)
+                self.add_change(session, node_type, identifier,
+                    'parent_added', parent_name)
         except IntegrityError:
             pass
 
@@ -242,6 +373,21 @@ class SQLBackend(Backend):
                 child_id=child.id,
                 parent_id=parent.id
             ).delete(False)
+            self.add_change(session, node_type, identifier,
+                'parent_removed', parent_name)
+
+    @staticmethod
+    def add_change(session, node_type, identifier, action, value,
+            server_id=-1):
+        """Add a change, so other servers can apply it with their next
+        synchronization."""
+        session.add(Change(
+            type=node_type,
+            identifier=str(identifier),
+            action=action,
+            value=value,
+            server_id=server_id
+        ))
 
     @staticmethod
     def get_node_type_and_identifier(node):
@@ -51,11 +51,19 @@ GUEST_PARENT_NAME = 'guest'
 class PermissionBase(dict):
     """Base class for parent and player permissions."""
 
-    def __init__(self, name):
-        """Initialize the object."""
+    def __init__(self, name, parent_dict=None):
+        """Initialize the object.
+
+        :param str name:
+            Name of the object.
+        :param ParentPermissionDict parent_dict:
+            The dictionary parents are retrieved from. If None,
+            :attr:`_AuthManager.parents` will be used.
+        """
         super().__init__()
         self.parents = set()
         self.name = name
+        self._parent_dict = parent_dict
         if self.name != GUEST_PARENT_NAME:
             # Don't update the backend, because it's a hidden group
             self.add_parent(GUEST_PARENT_NAME, update_backend=False)
@@ -115,7 +123,7 @@ class PermissionBase(dict):
         :param bool update_backend:
             If True, the backend will be updated.
         """
-        parent = auth_manager.parents[parent_name]
+        parent = self._get_parent_dict()[parent_name]
         if parent not in self.parents:
             # TODO: Detect cycles
             self.parents.add(parent)
@@ -132,7 +140,7 @@ class PermissionBase(dict):
         :param bool update_backend:
             If True, the backend will be updated.
         """
-        parent = auth_manager.parents[parent_name]
+        parent = self._get_parent_dict()[parent_name]
         if parent in self.parents:
             self.parents.remove(parent)
             parent.children.remove(self)
@@ -140,6 +148,13 @@ class PermissionBase(dict):
         if update_backend and auth_manager.active_backend is not None:
             auth_manager.active_backend.parent_removed(self, parent_name)
 
+    def _get_parent_dict(self):
+        """Return the dictionary parents are retrieved from."""
+        if self._parent_dict is None:
+            return auth_manager.parents
+
+        return self._parent_dict
+
     @staticmethod
     def _compile_permission(permission):
         """Compile a permission."""
@@ -189,7 +204,7 @@ class PermissionBase(dict):
 class PlayerPermissions(PermissionBase):
     """A container for player permissions."""
 
-    def __init__(self, name, steamid64):
+    def __init__(self, name, steamid64, parent_dict=None):
         """Initialize the object.
 
         :param str name:
@@ -197,21 +212,25 @@ class PlayerPermissions(PermissionBase):
         :param int steamid64:
             The SteamID64 value that was also used to store the object in the
             :class:PlayerPermissionDict`` object.
+        :param ParentPermissionDict parent_dict:
+            The dictionary parents are retrieved from.
         """
-        super().__init__(name)
+        super().__init__(name, parent_dict)
         self.steamid64 = steamid64
 
 
 class ParentPermissions(PermissionBase):
     """A container for parent permissions."""
 
-    def __init__(self, name):
+    def __init__(self, name, parent_dict=None):
         """Initialize the object.
 
         :param str name:
             Name of the parent.
+        :param ParentPermissionDict parent_dict:
+            The dictionary parents are retrieved from.
         """
-        super().__init__(name)
+        super().__init__(name, parent_dict)
         self.children = set()
 
 
@@ -233,11 +252,21 @@ class ParentPermissionDict(_PermissionDict):
             The name of the parent to retrieve.
         :rtype: ParentPermissions
         """
-        instance = self[parent_name] = ParentPermissions(parent_name)
+        instance = self[parent_name] = ParentPermissions(parent_name, self)
         return instance
 
 
 class PlayerPermissionDict(_PermissionDict):
+    def __init__(self, parent_dict=None):
+        """Initialize the object.
+
+        :param ParentPermissionDict parent_dict:
+            The dictionary the parents of the players are retrieved from. If
+            None, :attr:`_AuthManager.parents` will be used.
+        """
+        super().__init__()
+        self.parent_dict = parent_dict
+
     def __missing__(self, steamid):
         """Create, store and return a :class:`PlayerPermissions` object.
 
@@ -252,9 +281,11 @@ class PlayerPermissionDict(_PermissionDict):
 
             # We got a SteamID in a string format, so we can store it by using
             # its SteamID64 value, but keep the original name.
-            instance = self[steamid64] = PlayerPermissions(steamid, steamid64)
+            instance = self[steamid64] = PlayerPermissions(
+                steamid, steamid64, self.parent_dict)
         else:
-            instance = self[steamid] = PlayerPermissions(steamid, steamid)
+            instance = self[steamid] = PlayerPermissions(
+                steamid, steamid, self.parent_dict)
 
         return instance
 
@@ -265,7 +296,7 @@ class _AuthManager(dict):
     def __init__(self):
         """Initialize the object."""
         self.parents = ParentPermissionDict()
-        self.players = PlayerPermissionDict()
+        self.players = PlayerPermissionDict(self.parents)
         self.active_backend = None
         self.server_id = -1
 
@@ -324,6 +355,17 @@ class _AuthManager(dict):
             self.players.clear()
             self.active_backend = None
 
+    def replace_permissions(self, parents, players):
+        """Replace all stored parents and players at once.
+
+        :param ParentPermissionDict parents:
+            The new parents.
+        :param PlayerPermissionDict players:
+            The new players. They must retrieve their parents from
+            ``parents``.
+        """
+        self.parents, self.players = parents, players
+
     def is_backend_loaded(self, backend_name):
         """Return True if the given backend is currently loaded.
 
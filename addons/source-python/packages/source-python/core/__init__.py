@@ -14,10 +14,16 @@ from collections import defaultdict
 from contextlib import contextmanager
 #   Hashlib
 import hashlib
+#   Importlib
+from importlib.machinery import PathFinder
+from importlib.util import find_spec
+from importlib import import_module
 #   Inspect
 from inspect import getmodule
 from inspect import getmodulename
 from inspect import currentframe
+#   Marshal
+import marshal
 #   OS
 from os import sep
 #   Path
@@ -26,6 +32,8 @@ from path import Path
 from platform import system
 #   Sys
 import sys
+#   Types
+from types import ModuleType
 #   Urllib
 from urllib.request import urlopen
 #   Weakref
@@ -37,8 +45,10 @@ from configobj import ConfigObj
 
 # Source.Python Imports
 #   Paths
+from paths import CACHE_PATH
 from paths import GAME_PATH
 from paths import PLUGIN_PATH
+from paths import SP_PACKAGES_PATH
 
 
 
@@ -73,6 +83,7 @@ __all__ = ('AutoUnload',
            'create_checksum',
            'echo_console',
            'get_core_modules',
+           'get_game_data',
            'get_interface',
            'get_public_ip',
            'ignore_unicode_errors',
@@ -89,6 +100,12 @@ GAME_NAME = GAME_PATH.namebase
 # Get the platform the server is on
 PLATFORM = system().lower()
 
+# Directory that stores the parsed game data files
+_GAME_DATA_CACHE_PATH = CACHE_PATH / 'game_data'
+
+# Increase this value if the format of the cached game data changes
+_GAME_DATA_CACHE_VERSION = 1
+
 
 # =============================================================================
 # >> CLASSES
@@ -184,6 +201,174 @@ class GameConfigObj(ConfigObj):
         self.merge(ConfigObj(path / GAME_NAME / name, *args, **kwargs))
 
 
+class _GameDataCache(object):
+    """Class used to cache the merged data of GameConfigObj instances."""
+
+    def __init__(self):
+        """Initialize the cache."""
+        # Set to False to always parse the files
+        self.enabled = True
+
+        # Statistics printed with the startup profile
+        self.hits = 0
+        self.misses = 0
+
+    def get(self, infile):
+        """Return the merged data of the given file as a ConfigObj.
+
+        The data is loaded from the cache if none of the merged files has
+        changed since the cache file has been written.
+        """
+        # File objects and lists can't be validated
+        if not self.enabled or not isinstance(infile, str):
+            return GameConfigObj(infile)
+
+        # Get the files GameConfigObj merges and their current hashes
+        path, name = Path(infile).splitpath()
+        engine_path = path / SOURCE_ENGINE
+        files = (infile, engine_path / name, engine_path / GAME_NAME / name)
+        hashes = tuple(map(self._get_file_hash, files))
+
+        cache_file = _GAME_DATA_CACHE_PATH / hashlib.sha1(
+            Path(infile).normcase().encode('utf-8')).hexdigest() + '.bin'
+
+        # Try to load the data from the cache file
+        try:
+            with open(cache_file, 'rb') as f:
+                version, cached_hashes, data = marshal.load(f)
+        except (OSError, EOFError, ValueError, TypeError):
+            pass
+        else:
+            if (version == _GAME_DATA_CACHE_VERSION and
+                    tuple(cached_hashes) == hashes):
+                self.hits += 1
+                return ConfigObj(data)
+
+        # Parse the files and store the result for the next start
+        self.misses += 1
+        config = GameConfigObj(infile)
+        data = config.dict()
+        try:
+            if not _GAME_DATA_CACHE_PATH.isdir():
+                _GAME_DATA_CACHE_PATH.makedirs()
+
+            with open(cache_file, 'wb') as f:
+                marshal.dump((_GAME_DATA_CACHE_VERSION, hashes, data), f)
+        except (OSError, ValueError):
+            pass
+
+        return config
+
+    @staticmethod
+    def _get_file_hash(path):
+        """Return the SHA-1 hash of the given file or None if it's missing."""
+        try:
+            with open(path, 'rb') as f:
+                return hashlib.sha1(f.read()).hexdigest()
+        except OSError:
+            return None
+
+# Get the _GameDataCache instance
+_game_data_cache = _GameDataCache()
+
+
+class _LazyPackage(ModuleType):
+    """Module class that imports submodules on first attribute access.
+
+    This allows accessing e.g. ``entities.helpers`` after ``import entities``
+    without importing all submodules when the package is imported.
+    """
+
+    def __getattr__(self, name):
+        """Import the submodule with the given name."""
+        if name.startswith('__'):
+            raise AttributeError(name)
+
+        full_name = self.__name__ + '.' + name
+        try:
+            spec = find_spec(full_name)
+        except (ImportError, ValueError):
+            spec = None
+
+        if spec is None:
+            raise AttributeError(
+                'module "{0}" has no attribute "{1}"'.format(
+                    self.__name__, name))
+
+        # The import system stores the submodule as an attribute of the
+        # package, so __getattr__ isn't called again for it
+        return import_module(full_name)
+
+
+class _LazyPackageLoader(object):
+    """Loader wrapper that turns packages into _LazyPackage instances."""
+
+    def __init__(self, loader):
+        """Store the original loader."""
+        self.loader = loader
+
+    def __getattr__(self, attr):
+        """Forward e.g. get_source() to the original loader."""
+        return getattr(self.loader, attr)
+
+    def create_module(self, spec):
+        """Let the original loader create the module."""
+        return self.loader.create_module(spec)
+
+    def exec_module(self, module):
+        """Execute the package using the original loader."""
+        module.__class__ = _LazyPackage
+        self.loader.exec_module(module)
+
+
+class _LazyPackageFinder(object):
+    """Meta path finder for Source.Python's packages.
+
+    .. note::
+
+        Packages whose ``__init__`` imports its submodules still load them
+        when the package is imported. Only submodules that are not imported
+        by their package are loaded on first access.
+    """
+
+    # Names of the top-level packages in SP_PACKAGES_PATH. Other imports
+    # are left to the default finders right away.
+    packages = frozenset()
+
+    @classmethod
+    def find_spec(cls, fullname, path=None, target=None):
+        """Return the spec of the package with a _LazyPackageLoader."""
+        if fullname.partition('.')[0] not in cls.packages:
+            return None
+
+        spec = PathFinder.find_spec(fullname, path, target)
+        if (spec is None or spec.submodule_search_locations is None or
+                spec.loader is None or spec.origin is None or
+                not spec.origin.startswith(SP_PACKAGES_PATH)):
+            return None
+
+        spec.loader = _LazyPackageLoader(spec.loader)
+        return spec
+
+    @classmethod
+    def install(cls):
+        """Install the finder and update all imported packages."""
+        if cls in sys.meta_path:
+            return
+
+        cls.packages = frozenset(
+            directory.name for directory in SP_PACKAGES_PATH.dirs()
+            if directory.joinpath('__init__.py').isfile())
+
+        sys.meta_path.insert(0, cls)
+        for module in tuple(sys.modules.values()):
+            if (type(module) is ModuleType and
+                    hasattr(module, '__path__') and
+                    (getattr(module, '__file__', None) or '').startswith(
+                        SP_PACKAGES_PATH)):
+                module.__class__ = _LazyPackage
+
+
 # =============================================================================
 # >> FUNCTIONS
 # =============================================================================
@@ -313,6 +498,18 @@ def server_output(action=OutputReturn.CONTINUE):
     finally:
         OnServerOutput.manager.unregister_listener(intercepter)
 
+def get_game_data(infile):
+    """Return the merged game data of the given file.
+
+    The result equals ``GameConfigObj(infile)``, but is loaded from a cache
+    file if none of the merged files has changed.
+
+    :param str infile:
+        Path to the game data file.
+    :rtype: ConfigObj
+    """
+    return _game_data_cache.get(infile)
+
 def create_checksum(data, ignore_wchars=True):
     """Create an MD5 checksum for the given string.
 
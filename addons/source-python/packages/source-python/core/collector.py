@@ -0,0 +1,21 @@
+# ../core/collector.py
+
+"""Provides garbage collections that are run between ticks."""
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from _core._collector import COLLECTOR_GENERATIONS
+from _core._collector import TickCollector
+from _core._collector import tick_collector
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('COLLECTOR_GENERATIONS',
+           'TickCollector',
+           'tick_collector',
+           )
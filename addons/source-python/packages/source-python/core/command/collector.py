@@ -0,0 +1,99 @@
+# ../core/command/collector.py
+
+"""Registers the sp gc sub-commands."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   GC
+import gc
+
+# Source.Python Imports
+#   Commands
+from commands.typed import TypedServerCommand
+#   Core
+from core.collector import COLLECTOR_GENERATIONS
+from core.collector import tick_collector
+from core.command import core_command
+from core.command import core_command_logger
+
+
+# =============================================================================
+# >> GLOBALS
+# =============================================================================
+logger = core_command_logger.gc
+
+
+# =============================================================================
+# >> sp gc
+# =============================================================================
+@core_command.server_sub_command(['gc', 'enable'])
+def _sp_gc_enable(command_info, budget:float=None):
+    """Run garbage collections between ticks.
+
+    If a budget is given, collections may use that percentage of the tick
+    interval.
+    """
+    if budget is not None:
+        tick_collector.budget = budget
+
+    tick_collector.enabled = True
+    logger.log_message(
+        'Garbage collections are run between ticks ({0:.1f}% of the tick '
+        'interval).'.format(tick_collector.budget))
+
+@core_command.server_sub_command(['gc', 'disable'])
+def _sp_gc_disable(command_info):
+    """Let Python run garbage collections automatically again."""
+    tick_collector.enabled = False
+    logger.log_message('Garbage collections are no longer run between ticks.')
+
+@core_command.server_sub_command(['gc', 'collect'])
+def _sp_gc_collect(command_info, generation:int=COLLECTOR_GENERATIONS - 1):
+    """Collect a generation immediately."""
+    collected = tick_collector.collect(generation)
+    logger.log_message(
+        'Generation {0} has been collected. {1} unreachable objects have '
+        'been found.'.format(generation, collected))
+
+@core_command.server_sub_command(['gc', 'reset'])
+def _sp_gc_reset(command_info):
+    """Remove all recorded collections."""
+    tick_collector.reset()
+    logger.log_message('The garbage collection statistics have been reset.')
+
+@core_command.server_sub_command(['gc', 'print'])
+def _sp_gc_print(command_info):
+    """Print the recorded collections of each generation."""
+    message = 'Garbage collections{0}:\n'.format(
+        '' if tick_collector.enabled else ' (disabled)')
+    message += (
+        '{0:>10} {1:>10} {2:>10} {3:>10} {4:>10} {5:>10} {6:>10}\n'.format(
+            'Generation', 'Calls', 'Forced', 'Objects', 'Total ms', 'Max ms',
+            'Expect ms'))
+
+    for generation, (calls, forced, collected, total, maximum, expected) in \
+            enumerate(tick_collector.get_stats()):
+        message += (
+            '{0:>10} {1:>10} {2:>10} {3:>10} {4:>10.3f} {5:>10.3f} '
+            '{6:>10.3f}\n'.format(
+                generation, calls, forced, collected, total, maximum,
+                expected))
+
+    message += 'Pending: {0}, thresholds: {1}\n'.format(
+        gc.get_count(), gc.get_threshold())
+    message += (
+        'Budget: {0:.1f}%, available in the last frame: {1:.3f} ms\n'.format(
+            tick_collector.budget, tick_collector.last_available_time))
+    message += 'Deferred ticks: {0}, level shutdown collections: {1}\n'.format(
+        tick_collector.deferred_ticks, tick_collector.level_collections)
+
+    logger.log_message(message)
+
+
+# =============================================================================
+# >> DESCRIPTIONS
+# =============================================================================
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'gc'], 'Run garbage collections between ticks.')
@@ -0,0 +1,51 @@
+# ../core/command/metrics.py
+
+"""Registers the sp metrics sub-commands."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Commands
+from commands.typed import TypedServerCommand
+#   Core
+from core.command import core_command
+from core.command import core_command_logger
+from core.metrics import metrics
+
+
+# =============================================================================
+# >> GLOBALS
+# =============================================================================
+logger = core_command_logger.metrics
+
+
+# =============================================================================
+# >> sp metrics
+# =============================================================================
+@core_command.server_sub_command(['metrics', 'print'])
+def _sp_metrics_print(command_info):
+    """Print all metrics in the Prometheus text format."""
+    message = metrics.format_prometheus()
+    if metrics.shared_memory_name is not None:
+        message += '\nShared memory: {0}'.format(metrics.shared_memory_name)
+
+    if metrics.socket_path is not None:
+        message += '\nSocket: {0}'.format(metrics.socket_path)
+
+    logger.log_message(message)
+
+@core_command.server_sub_command(['metrics', 'reset'])
+def _sp_metrics_reset(command_info):
+    """Set all metrics back to zero."""
+    for index in range(len(metrics)):
+        metrics.reset(index)
+
+    logger.log_message('All metrics have been reset.')
+
+
+# =============================================================================
+# >> DESCRIPTIONS
+# =============================================================================
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'metrics'], 'Show Source.Python\'s metrics.')
@@ -0,0 +1,141 @@
+# ../core/command/profile.py
+
+"""Registers the sp profile sub-commands."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Commands
+from commands.typed import TypedServerCommand
+#   Core
+from core.command import core_command
+from core.command import core_command_logger
+from core.profiler import callback_profiler
+from core.profiler import frame_budget
+from core.profiler import startup_profiler
+
+
+# =============================================================================
+# >> GLOBALS
+# =============================================================================
+logger = core_command_logger.profile
+
+
+# =============================================================================
+# >> sp profile
+# =============================================================================
+@core_command.server_sub_command(['profile', 'startup'])
+def _sp_profile_startup(command_info, min_time:float=0.0):
+    """Print the load times of Source.Python and all plugins.
+
+    A folded stack file for flame graphs is written to the log directory.
+    """
+    lines = startup_profiler.get_report_lines(min_time)
+    path = startup_profiler.dump_folded_stacks()
+    logger.log_message(
+        'Startup profile:\n' + '\n'.join(lines) +
+        '\n\nFolded stacks have been written to {0}.'.format(path))
+
+
+@core_command.server_sub_command(['profile', 'hooks', 'enable'])
+def _sp_profile_hooks_enable(command_info):
+    """Start profiling hook and listener callbacks."""
+    callback_profiler.enabled = True
+    logger.log_message('Hook and listener callbacks are being profiled.')
+
+@core_command.server_sub_command(['profile', 'hooks', 'disable'])
+def _sp_profile_hooks_disable(command_info):
+    """Stop profiling hook and listener callbacks."""
+    callback_profiler.enabled = False
+    logger.log_message('Hook and listener callbacks are no longer profiled.')
+
+@core_command.server_sub_command(['profile', 'hooks', 'reset'])
+def _sp_profile_hooks_reset(command_info):
+    """Remove all recorded values of hook and listener callbacks."""
+    callback_profiler.reset()
+    logger.log_message('The hook and listener profile has been reset.')
+
+@core_command.server_sub_command(['profile', 'hooks', 'print'])
+def _sp_profile_hooks_print(command_info, count:int=20):
+    """Print the callbacks that took the most time."""
+    profiles = sorted(
+        callback_profiler.get_profiles(),
+        key=lambda profile: profile[2], reverse=True)
+
+    message = 'Hook and listener profile{0}:\n'.format(
+        '' if callback_profiler.enabled else ' (disabled)')
+    message += '{0:>10} {1:>10} {2:>10} {3:>10}  {4}\n'.format(
+        'Calls', 'Total ms', 'Avg us', 'Max us', 'Callback')
+    for name, calls, total, maximum in profiles[:count]:
+        message += '{0:>10} {1:>10.3f} {2:>10.1f} {3:>10.1f}  {4}\n'.format(
+            calls, total * 1000, total / calls * 1000000, maximum * 1000000,
+            name)
+
+    if callback_profiler.overflows:
+        message += '{0} calls could not be recorded.\n'.format(
+            callback_profiler.overflows)
+
+    logger.log_message(message)
+
+@core_command.server_sub_command(['profile', 'frames', 'enable'])
+def _sp_profile_frames_enable(command_info, threshold:float=None):
+    """Start measuring Source.Python's share of each frame.
+
+    If a threshold in milliseconds is given, OnTickBudgetExceeded listeners
+    are called when a frame exceeds it.
+    """
+    if threshold is not None:
+        frame_budget.threshold = threshold
+
+    frame_budget.enabled = True
+    logger.log_message('Frame times are being measured.')
+
+@core_command.server_sub_command(['profile', 'frames', 'disable'])
+def _sp_profile_frames_disable(command_info):
+    """Stop measuring Source.Python's share of each frame."""
+    frame_budget.enabled = False
+    logger.log_message('Frame times are no longer measured.')
+
+@core_command.server_sub_command(['profile', 'frames', 'reset'])
+def _sp_profile_frames_reset(command_info):
+    """Remove all recorded frame times."""
+    frame_budget.reset()
+    logger.log_message('The frame profile has been reset.')
+
+@core_command.server_sub_command(['profile', 'frames', 'print'])
+def _sp_profile_frames_print(command_info):
+    """Print the distribution of Source.Python's frame times."""
+    histogram = frame_budget.histogram
+    message = 'Frame profile{0}:\n'.format(
+        '' if frame_budget.enabled else ' (disabled)')
+    message += 'Frames: {0}, mean: {1:.3f} ms, max: {2:.3f} ms\n'.format(
+        histogram.count, histogram.mean / 1000, histogram.max / 1000)
+
+    for percentile in (50, 90, 99, 99.9):
+        message += '{0:>6}%: {1:.3f} ms\n'.format(
+            percentile, histogram.get_value_at_percentile(percentile) / 1000)
+
+    if frame_budget.threshold > 0:
+        message += 'Frames above {0:.3f} ms: {1}\n'.format(
+            frame_budget.threshold, frame_budget.exceeded)
+
+    message += 'Last frame: ' + ', '.join(
+        '{0}={1:.3f} ms'.format(name, value) for name, value in sorted(
+            frame_budget.get_last_frame_breakdown().items())) + '\n'
+
+    logger.log_message(message)
+
+
+# =============================================================================
+# >> DESCRIPTIONS
+# =============================================================================
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'profile'], 'Profile Source.Python.')
+
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'profile', 'hooks'], 'Profile hook and listener callbacks.')
+
+TypedServerCommand.parser.set_node_description(
+    ['sp', 'profile', 'frames'],
+    'Measure Source.Python\'s share of each frame.')
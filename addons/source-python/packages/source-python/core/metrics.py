@@ -0,0 +1,159 @@
+# ../core/metrics.py
+
+"""Provides counters, gauges and histograms that can be read externally."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   Contextlib
+from contextlib import contextmanager
+#   GC
+import gc
+#   Time
+from time import perf_counter
+
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from _core._metrics import METRICS_DEFAULT_SHM_NAME
+from _core._metrics import METRICS_HISTOGRAM_BUCKETS
+from _core._metrics import METRICS_HISTOGRAM_OFFSET
+from _core._metrics import METRICS_MAGIC
+from _core._metrics import METRICS_MAX_METRICS
+from _core._metrics import METRICS_NAME_LENGTH
+from _core._metrics import METRICS_VERSION
+from _core._metrics import MetricType
+from _core._metrics import MetricsRegistry
+from _core._metrics import metrics
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('CounterMetric',
+           'GaugeMetric',
+           'HistogramMetric',
+           'METRICS_DEFAULT_SHM_NAME',
+           'METRICS_HISTOGRAM_BUCKETS',
+           'METRICS_HISTOGRAM_OFFSET',
+           'METRICS_MAGIC',
+           'METRICS_MAX_METRICS',
+           'METRICS_NAME_LENGTH',
+           'METRICS_VERSION',
+           'MetricType',
+           'MetricsRegistry',
+           'metrics',
+           )
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class _Metric(object):
+    """Base class for metrics of the main :class:`MetricsRegistry`."""
+
+    metric_type = None
+
+    def __init__(self, name):
+        """Register the metric.
+
+        Registering a name twice returns the same metric, so plugins can
+        create their metrics again after being reloaded.
+
+        :param str name:
+            Name of the metric. Must be a valid Prometheus metric name.
+        :raise ValueError:
+            Raised if the name is invalid or already used by a metric of
+            another type.
+        """
+        self.name = name
+        self.index = metrics.register(name, self.metric_type)
+
+    @property
+    def value(self):
+        """Return the current value of the metric."""
+        return metrics.get_value(self.index)
+
+    def reset(self):
+        """Set the value of the metric back to zero."""
+        metrics.reset(self.index)
+
+
+class CounterMetric(_Metric):
+    """A value that only increases."""
+
+    metric_type = MetricType.COUNTER
+
+    def increment(self, value=1):
+        """Increment the counter.
+
+        :param int value:
+            The value to add.
+        """
+        metrics.increment(self.index, value)
+
+
+class GaugeMetric(_Metric):
+    """A value that can be set to anything."""
+
+    metric_type = MetricType.GAUGE
+
+    def set(self, value):
+        """Set the value of the gauge.
+
+        :param float value:
+            The new value.
+        """
+        metrics.set_gauge(self.index, value)
+
+
+class HistogramMetric(_Metric):
+    """Counts values in power of two buckets."""
+
+    metric_type = MetricType.HISTOGRAM
+
+    def observe(self, value):
+        """Add a value to the histogram.
+
+        :param float value:
+            The value to add.
+        """
+        metrics.observe(self.index, value)
+
+    @contextmanager
+    def time(self):
+        """Add the milliseconds spent within the with statement."""
+        start = perf_counter()
+        try:
+            yield
+        finally:
+            metrics.observe(self.index, (perf_counter() - start) * 1000)
+
+
+# =============================================================================
+# >> GARBAGE COLLECTION
+# =============================================================================
+_gc_pause = HistogramMetric('sp_gc_pause_ms')
+_gc_collections = CounterMetric('sp_gc_collections_total')
+_gc_start = None
+
+
+def _on_gc(phase, info):
+    """Record the duration of each garbage collection."""
+    global _gc_start
+    if phase == 'start':
+        _gc_start = perf_counter()
+        return
+
+    if _gc_start is None:
+        return
+
+    _gc_pause.observe((perf_counter() - _gc_start) * 1000)
+    _gc_collections.increment()
+    _gc_start = None
+
+gc.callbacks.append(_on_gc)
@@ -0,0 +1,231 @@
+# ../core/profiler.py
+
+"""Provides a hierarchical profiler for Source.Python's load times."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Python Imports
+#   Collections
+from collections import OrderedDict
+#   Contextlib
+from contextlib import contextmanager
+#   Sys
+import sys
+#   Time
+from time import perf_counter
+
+# Source.Python Imports
+#   Paths
+from paths import LOG_PATH
+
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from _core._profiler import CallbackProfiler
+from _core._profiler import FrameBudget
+from _core._profiler import Histogram
+from _core._profiler import callback_profiler
+from _core._profiler import frame_budget
+#   Memory
+from _memory import scan_statistics
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('CallbackProfiler',
+           'FrameBudget',
+           'Histogram',
+           'ProfileNode',
+           'StartupProfiler',
+           'callback_profiler',
+           'frame_budget',
+           'startup_profiler',
+           )
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class ProfileNode(object):
+    """Stores the accumulated values of a profiled section."""
+
+    def __init__(self, name, parent=None):
+        """Initialize the node.
+
+        :param str name:
+            Name of the section.
+        :param ProfileNode parent:
+            The section this section has been entered from.
+        """
+        self.name = name
+        self.parent = parent
+        self.children = OrderedDict()
+
+        # Accumulated values. Values of child sections are included.
+        self.calls = 0
+        self.time = 0.0
+        self.imports = 0
+        self.lookups = 0
+        self.scanned_bytes = 0
+
+    def get_child(self, name):
+        """Return the child section with the given name.
+
+        :param str name:
+            Name of the child section.
+        :rtype: ProfileNode
+        """
+        try:
+            return self.children[name]
+        except KeyError:
+            node = self.children[name] = ProfileNode(name, self)
+            return node
+
+    @property
+    def self_time(self):
+        """Return the time that has not been spent in a child section.
+
+        :rtype: float
+        """
+        return max(0.0, self.time - sum(
+            child.time for child in self.children.values()))
+
+    def walk(self, depth=0):
+        """Yield this node and all of its children with their depth."""
+        yield (self, depth)
+        for child in self.children.values():
+            yield from child.walk(depth + 1)
+
+
+class StartupProfiler(object):
+    """Records wall time, imports and binary scans of nested sections."""
+
+    def __init__(self):
+        """Initialize the profiler."""
+        self.enabled = True
+        self.root = ProfileNode('source-python')
+        self._stack = [(self.root, None)]
+
+    def begin(self, name):
+        """Enter a section.
+
+        Every call must be followed by a call to :meth:`end`.
+
+        :param str name:
+            Name of the section.
+        """
+        node = self._stack[-1][0].get_child(name)
+        self._stack.append((node, (
+            perf_counter(),
+            len(sys.modules),
+            scan_statistics.signatures + scan_statistics.symbols,
+            scan_statistics.scanned_bytes)))
+
+    def end(self):
+        """Leave the current section and store its values."""
+        node, (start, imports, lookups, scanned_bytes) = self._stack.pop()
+        node.calls += 1
+        node.time += perf_counter() - start
+        node.imports += len(sys.modules) - imports
+        node.lookups += (
+            scan_statistics.signatures + scan_statistics.symbols - lookups)
+        node.scanned_bytes += scan_statistics.scanned_bytes - scanned_bytes
+
+    @contextmanager
+    def section(self, name):
+        """Profile the code within the with statement.
+
+        :param str name:
+            Name of the section.
+        """
+        if not self.enabled:
+            yield
+            return
+
+        self.begin(name)
+        try:
+            yield
+        finally:
+            self.end()
+
+    def add(self, name, time):
+        """Add a section that has been timed elsewhere.
+
+        :param str name:
+            Name of the section.
+        :param float time:
+            Duration of the section in seconds.
+        """
+        node = self._stack[-1][0].get_child(name)
+        node.calls += 1
+        node.time += time
+
+    def reset(self):
+        """Remove all recorded sections."""
+        self.root.children.clear()
+
+    def get_report_lines(self, min_time=0.0):
+        """Return the recorded sections as indented lines.
+
+        :param float min_time:
+            Sections that took less seconds are left out.
+        :rtype: list
+        """
+        lines = []
+        for node, depth in self.root.walk():
+            if node is self.root or node.time < min_time:
+                continue
+
+            line = '{0}{1}: {2:.3f}s'.format(
+                '  ' * (depth - 1), node.name, node.time)
+            if node.calls > 1:
+                line += ', {0} calls'.format(node.calls)
+            if node.imports:
+                line += ', {0} imports'.format(node.imports)
+            if node.lookups:
+                line += ', {0} lookups ({1} bytes scanned)'.format(
+                    node.lookups, node.scanned_bytes)
+
+            lines.append(line)
+
+        return lines
+
+    def iter_folded_stacks(self):
+        """Yield each section as a line of the folded stack format.
+
+        The value of each line is the self time in microseconds, so the
+        result can be passed to flamegraph.pl.
+        """
+        for node, depth in self.root.walk():
+            names = []
+            parent = node
+            while parent is not None:
+                names.append(parent.name.replace(';', ':').replace(' ', '_'))
+                parent = parent.parent
+
+            yield '{0} {1}'.format(
+                ';'.join(reversed(names)), int(node.self_time * 1000000))
+
+    def dump_folded_stacks(self, file_name='startup_profile.folded'):
+        """Write the folded stacks to a file in the log directory.
+
+        :param str file_name:
+            Name of the file.
+        :return:
+            Path to the written file.
+        :rtype: path.Path
+        """
+        path = LOG_PATH / file_name
+        with path.open('w') as f:
+            for line in self.iter_folded_stacks():
+                f.write(line + '\n')
+
+        return path
+
+#: The main :class:`StartupProfiler` instance.
+startup_profiler = StartupProfiler()
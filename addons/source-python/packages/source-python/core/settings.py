@@ -41,6 +41,11 @@ class _CoreSettings(ConfigObj):
         super().__init__(infile, *args, **kwargs)
         self._language = None
         self.auto_data_update = True
+        self.game_data_cache = True
+        self.tick_budget = 0.0
+        self.metrics_shm = ''
+        self.metrics_socket = ''
+        self.gc_tick_budget = 0.0
 
     def load(self):
         """Load and update the core settings."""
@@ -97,6 +102,53 @@ class _CoreSettings(ConfigObj):
         self['BASE_SETTINGS'].comments['auto_data_update'] = _core_strings[
             'auto_data_update'].get_string(self._language).splitlines()
 
+        if 'game_data_cache' not in self['BASE_SETTINGS']:
+            self['BASE_SETTINGS']['game_data_cache'] = '1'
+
+        self.game_data_cache = self['BASE_SETTINGS']['game_data_cache'] == '1'
+
+        self['BASE_SETTINGS'].comments['game_data_cache'] = _core_strings[
+            'game_data_cache'].get_string(self._language).splitlines()
+
+        if 'tick_budget' not in self['BASE_SETTINGS']:
+            self['BASE_SETTINGS']['tick_budget'] = '0'
+
+        try:
+            self.tick_budget = float(self['BASE_SETTINGS']['tick_budget'])
+        except ValueError:
+            self.tick_budget = 0.0
+
+        self['BASE_SETTINGS'].comments['tick_budget'] = _core_strings[
+            'tick_budget'].get_string(self._language).splitlines()
+
+        if 'metrics_shm' not in self['BASE_SETTINGS']:
+            self['BASE_SETTINGS']['metrics_shm'] = ''
+
+        self.metrics_shm = self['BASE_SETTINGS']['metrics_shm'].strip()
+
+        self['BASE_SETTINGS'].comments['metrics_shm'] = _core_strings[
+            'metrics_shm'].get_string(self._language).splitlines()
+
+        if 'metrics_socket' not in self['BASE_SETTINGS']:
+            self['BASE_SETTINGS']['metrics_socket'] = ''
+
+        self.metrics_socket = self['BASE_SETTINGS']['metrics_socket'].strip()
+
+        self['BASE_SETTINGS'].comments['metrics_socket'] = _core_strings[
+            'metrics_socket'].get_string(self._language).splitlines()
+
+        if 'gc_tick_budget' not in self['BASE_SETTINGS']:
+            self['BASE_SETTINGS']['gc_tick_budget'] = '0'
+
+        try:
+            self.gc_tick_budget = float(
+                self['BASE_SETTINGS']['gc_tick_budget'])
+        except ValueError:
+            self.gc_tick_budget = 0.0
+
+        self['BASE_SETTINGS'].comments['gc_tick_budget'] = _core_strings[
+            'gc_tick_budget'].get_string(self._language).splitlines()
+
     def _check_version_settings(self):
         """Add version settings if they are missing."""
         if 'VERSION_SETTINGS' not in self:
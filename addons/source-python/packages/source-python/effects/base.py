@@ -82,11 +82,8 @@ class TempEntity(BaseTempEntity):
             # Initialize the temp entity...
             super()._copy_base(template, template.size)
 
-        # Loop through all given aliases...
-        for alias, value in aliases.items():
-
-            # Set the alias to the given value...
-            setattr(self, alias, value)
+        # Set the given aliases...
+        self.template.layout.fill(self, aliases)
 
     @classmethod
     def _obj(cls, ptr):
@@ -112,6 +109,12 @@ class TempEntity(BaseTempEntity):
             The alias name.
         :rtype: object
         """
+        # Read compiled aliases natively...
+        try:
+            return self.template.layout.get(self, name)
+        except KeyError:
+            pass
+
         # Get the name of the prop...
         prop_name = self.template.aliases.get(name, None)
 
@@ -200,6 +203,10 @@ class TempEntity(BaseTempEntity):
         :param object value:
             The value to set.
         """
+        # Write compiled aliases natively...
+        if self.template.layout.set(self, name, value):
+            return
+
         # Get the name of the prop...
         prop_name = self.template.aliases.get(name, None)
 
@@ -592,15 +599,38 @@ class TempEntity(BaseTempEntity):
         # Get a recipient filter matching the given players...
         recipients = RecipientFilter(*recipients)
 
-        # Loop trhough all given aliases...
-        for alias, value in aliases.items():
-
-            # Set the alias to the given value...
-            setattr(self, alias, value)
+        # Set the given aliases...
+        self.template.layout.fill(self, aliases)
 
         # Create the temp entity effect...
         super().create(recipients, delay)
 
+    def create_many(self, recipients, rows, delay=0.0):
+        """Create the temp entity effect once for each row.
+
+        Each row is applied to this temp entity before the effect is created,
+        so aliases that are not given by a row keep the value of the
+        previous one.
+
+        :param RecipientFilter recipients:
+            The recipient filter listing the players to send the effects to.
+            Any other iterable of players is converted to a filter.
+        :param iterable rows:
+            Dictionaries that map aliases to the values to set.
+        :param float delay:
+            The delay before creating the effects.
+        :return:
+            The number of created effects.
+        :rtype: int
+        """
+        # Get a recipient filter matching the given players...
+        if not isinstance(recipients, RecipientFilter):
+            recipients = RecipientFilter(*recipients)
+
+        # Fill and create all effects natively...
+        return self.template.layout.create_many(
+            self, recipients, rows, delay)
+
     @property
     def template(self):
         """Return the template of the temp entity.
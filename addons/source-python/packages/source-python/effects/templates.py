@@ -10,6 +10,7 @@
 from core import GameConfigObj
 #   Effects
 from _effects._base import BaseTempEntity
+from _effects._base import TempEntityLayout
 #   Entities
 from entities.classes import _supported_property_types
 from entities.classes import server_classes
@@ -37,6 +38,13 @@ __all__ = ('TempEntityTemplate',
            )
 
 
+# ============================================================================
+# >> GLOBAL VARIABLES
+# ============================================================================
+# Types of properties that can be read and written natively
+_native_field_types = ('int', 'float', 'Vector')
+
+
 # ============================================================================
 # >> CLASSES
 # ============================================================================
@@ -74,6 +82,9 @@ class TempEntityTemplate(BaseTempEntity):
             # Add the current table to the properties...
             self._add_properties(prop.data_table)
 
+        # Compile the aliases...
+        self._layout = self._compile_layout()
+
         # Get a list to store our hooks...
         self._hooks = list()
 
@@ -141,6 +152,56 @@ class TempEntityTemplate(BaseTempEntity):
             # Add the property...
             self._properties[name] = (prop, offset, type_name)
 
+    def _compile_layout(self):
+        """Compile the aliases that can be read and written natively.
+
+        :rtype: TempEntityLayout
+        """
+        # Done here to fix cyclic imports...
+        from engines.precache import Decal
+        from engines.precache import Model
+        from entities.entity import Entity
+        from players.entity import Player
+
+        # Get the classes of the aliases that store an index...
+        index_classes = {
+            Decal.__name__: Decal,
+            Entity.__name__: Entity,
+            Model.__name__: Model,
+            Player.__name__: None,
+        }
+
+        # Get the layout instance...
+        layout = TempEntityLayout()
+
+        # Add all aliases that directly refer to a property first...
+        sections = list()
+        for alias, prop_name in self.aliases.items():
+            if isinstance(prop_name, Section):
+                sections.append((alias, prop_name))
+                continue
+
+            if prop_name not in self.properties:
+                continue
+
+            prop, offset, type_name = self.properties[prop_name]
+            if type_name in _native_field_types:
+                layout.add_field(alias, offset, type_name)
+
+        # Add the aliases that refer to other aliases...
+        for alias, data in sections:
+            if data['type'] == 'Color':
+                names = tuple(data['name'])
+                if len(names) == 4 and all(name in layout for name in names):
+                    layout.add_color_alias(alias, names)
+
+            elif data['type'] in index_classes and data['name'] in layout:
+                layout.add_index_alias(
+                    alias, data['name'], index_classes[data['type']])
+
+        # Return the layout...
+        return layout
+
     @staticmethod
     def _get_type_size(type_name):
         """Helper method returning the size of the given type.
@@ -229,6 +290,14 @@ class TempEntityTemplate(BaseTempEntity):
         """
         return self._aliases
 
+    @property
+    def layout(self):
+        """Return the compiled aliases of the temp entity.
+
+        :rtype: TempEntityLayout
+        """
+        return self._layout
+
     @property
     def hooks(self):
         """Return the registered hooks for this temp entity.
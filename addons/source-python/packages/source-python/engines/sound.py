@@ -32,6 +32,7 @@ from filesystem import SourceFile
 #   Mathlib
 from mathlib import NULL_VECTOR
 #   Paths
+from paths import CACHE_PATH
 from paths import GAME_PATH
 #   Stringtables
 from stringtables import INVALID_STRING_INDEX, string_tables
@@ -53,10 +54,14 @@ from _engines._sound import ATTN_RICOCHET
 from _engines._sound import ATTN_GUNFIRE
 from _engines._sound import MAX_ATTENUATION
 from _engines._sound import SoundFlags
+from _engines._sound import SoundFormat
+from _engines._sound import SoundInfo
+from _engines._sound import SoundInfoIndex
 from _engines._sound import Pitch
 from _engines._sound import SOUND_FROM_LOCAL_PLAYER
 from _engines._sound import SOUND_FROM_WORLD
 from _engines._sound import engine_sound
+from _engines._sound import sound_info_index
 
 
 # =============================================================================
@@ -69,9 +74,13 @@ __all__ = ('Attenuation',
            'SOUND_FROM_WORLD',
            'Sound',
            'SoundFlags',
+           'SoundFormat',
+           'SoundInfo',
+           'SoundInfoIndex',
            'StreamSound',
            'VOL_NORM',
            'engine_sound',
+           'sound_info_index',
            )
 
 
@@ -81,6 +90,18 @@ __all__ = ('Attenuation',
 # Get the sp.engines.sound logger
 engines_sound_logger = engines_logger.sound
 
+# Path to the file that stores the sound info index between server starts
+SOUND_INFO_INDEX_PATH = CACHE_PATH / 'sound_info.bin'
+
+
+# Add the entries of the last server start
+if SOUND_INFO_INDEX_PATH.isfile():
+    try:
+        sound_info_index.load(SOUND_INFO_INDEX_PATH)
+    except (IOError, ValueError):
+        engines_sound_logger.log_debug(
+            'Unable to load the sound info index.')
+
 
 # =============================================================================
 # >> ENUMERATORS
@@ -171,6 +192,11 @@ class _BaseSound(WeakAutoUnload):
             self._downloads = Downloadables()
             self._downloads.add(self.relative_path)
 
+        # Parse the header of the sample in the background, so the duration
+        # is already known when it's requested
+        if self.relative_path not in sound_info_index:
+            sound_info_index.queue(self.relative_path)
+
     def play(self, *recipients):
         """Play the sound.
 
@@ -267,6 +293,44 @@ class _BaseSound(WeakAutoUnload):
         if self._duration is not None:
             return self._duration
 
+        try:
+            value = self.info.duration
+        except (IOError, ValueError):
+            value = self._parse_duration()
+
+        self._duration = value
+        return value
+
+    @property
+    def sample_rate(self):
+        """Return the number of samples per second of the sample.
+
+        :rtype: int
+        """
+        return self.info.sample_rate
+
+    @property
+    def channels(self):
+        """Return the number of channels of the sample.
+
+        :rtype: int
+        """
+        return self.info.channels
+
+    @property
+    def info(self):
+        """Return the header information of the sample.
+
+        :raise IOError:
+            Raised if the file could not be opened.
+        :raise ValueError:
+            Raised if the format of the file is not supported.
+        :rtype: SoundInfo
+        """
+        return sound_info_index.get(self.relative_path)
+
+    def _parse_duration(self):
+        """Return the duration of the sample parsed by mutagen or wave."""
         with closing(SourceFile.open(self.relative_path, 'rb')) as f:
             if self.extension == 'ogg':
                 value = oggvorbis.Open(f).info.length
@@ -282,7 +346,6 @@ class _BaseSound(WeakAutoUnload):
                     )
                 )
 
-        self._duration = value
         return value
 
     def _unload_instance(self):
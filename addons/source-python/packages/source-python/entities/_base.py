@@ -540,6 +540,9 @@ class Entity(BaseEntity, metaclass=_EntityCaching):
             function.
         :raise ValueError:
             Raised if the input function wasn't found.
+
+        .. seealso:: :func:`entities.datamaps.call_input_many` to call an
+            input on many entities at once.
         """
         self.get_input(name)(*args, **kwargs)
 
@@ -18,7 +18,7 @@ from configobj import Section
 
 # Source.Python Imports
 #   Core
-from core import GameConfigObj
+from core import get_game_data
 from core import PLATFORM
 #   Entities
 from _entities._entity import BaseEntity
@@ -223,7 +223,7 @@ class _ServerClasses(TypeManager):
     def _get_server_class(self, class_name, datamap):
         """Retrieve values for the server class."""
         # Get the engine specific data for the current class
-        manager_contents = GameConfigObj(_managers_path / class_name + '.ini')
+        manager_contents = get_game_data(_managers_path / class_name + '.ini')
 
         # Are there any values for the manager?
         if manager_contents:
@@ -291,7 +291,7 @@ class _ServerClasses(TypeManager):
                 instance, name, offset, property_contents, prop_type, True)
 
         # Loop through all possible descriptors for the server class
-        for name, desc, offset in self._find_descriptors(datamap):
+        for name, desc, offset in datamap.get_descriptors():
 
             # Is the current descriptor an Output?
             if desc.flags & TypeDescriptionFlags.OUTPUT:
@@ -434,37 +434,6 @@ class _ServerClasses(TypeManager):
                 # Yield the current property
                 yield (name, prop, offset)
 
-    def _find_descriptors(self, datamap, base_name='', base_offset=0):
-        """Find descriptors and yield their values."""
-        # Loop through all descriptors in the datamap
-        for desc in datamap:
-
-            # Get the name of the descriptor
-            name = (desc.name if desc.external_name
-                    is None else desc.external_name)
-
-            # Is the name valid?
-            if name is None:
-                continue
-
-            # Get the name of the descriptor using the given base name
-            # Base names are used in case of embedded datamap tables
-            name = base_name + name
-
-            # Get the updated offset of the descriptor
-            offset = base_offset + desc.offset
-
-            # Is the current descriptor an embedded datamap table?
-            if desc.type == FieldType.EMBEDDED:
-                yield from self._find_descriptors(
-                    desc.embedded_datamap, name + '.', offset)
-
-            # Is the current descriptor not an embedded datamap table?
-            else:
-
-                # Yield the current descriptor
-                yield (name, desc, offset)
-
     def _add_keyvalue(self, instance, name, desc, contents):
         """Add the keyvalue to the instance's keyvalues dictionary."""
         # Is the KeyValue already in the keyvalues dictionary?
@@ -42,6 +42,7 @@ from _entities._datamaps import InputFunction
 from _entities._datamaps import Interval
 from _entities._datamaps import TypeDescription
 from _entities._datamaps import Variant
+from _entities._datamaps import call_input_many
 
 
 # =============================================================================
@@ -57,6 +58,7 @@ __all__ = ('DataMap',
            'TypeDescription',
            'TypeDescriptionFlags',
            'Variant',
+           'call_input_many',
            )
 
 
@@ -92,7 +92,7 @@ class EntityCondition(object):
 class _EntityHook(AutoUnload):
     """Create entity pre and post hooks that auto unload."""
 
-    def __init__(self, test_function, function):
+    def __init__(self, test_function, function, hook_filter=None):
         """Initialize the hook object.
 
         :param callable test_function:
@@ -103,9 +103,29 @@ class _EntityHook(AutoUnload):
             This is the function to hook. It can be either a string that
             defines the name of a function of the entity or a callable object
             that returns a :class:`memory.Function` instance.
+        :param HookFilter hook_filter:
+            If given, the callback is only called for entities that are
+            accepted by the filter. Unlike a test in the callback, the filter
+            is evaluated before the callback is called, so calls of other
+            entities don't enter Python at all.
+
+            Example:
+
+            .. code:: python
+
+                from entities.hooks import EntityCondition
+                from entities.hooks import EntityPreHook
+                from memory.hooks import HookFilter
+
+                @EntityPreHook(
+                    EntityCondition.is_player, 'on_take_damage',
+                    HookFilter(datamaps=['CBasePlayer']))
+                def pre_on_take_damage(stack_data):
+                    ...
         """
         self.test_function = test_function
         self.function = function
+        self.hook_filter = hook_filter
         self.hooked_function = None
         self.callback = None
 
@@ -161,7 +181,8 @@ class _EntityHook(AutoUnload):
         else:
             self.hooked_function = getattr(entity, self.function)
 
-        self.hooked_function.add_hook(self.hook_type, self.callback)
+        self.hooked_function.add_hook(
+            self.hook_type, self.callback, self.hook_filter)
         return True
 
     def _unload_instance(self):
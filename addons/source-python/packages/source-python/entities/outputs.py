@@ -0,0 +1,95 @@
+# ../entities/outputs.py
+
+"""Provides entity output callbacks that are filtered natively."""
+
+# =============================================================================
+# >> IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Core
+from core import AutoUnload
+
+
+# =============================================================================
+# >> FORWARD IMPORTS
+# =============================================================================
+# Source.Python Imports
+#   Entities
+from _entities._outputs import EntityOutputRegistry
+from _entities._outputs import entity_output_registry
+
+
+# =============================================================================
+# >> ALL DECLARATION
+# =============================================================================
+__all__ = ('EntityOutputHook',
+           'EntityOutputRegistry',
+           'entity_output_registry',
+           )
+
+
+# =============================================================================
+# >> CLASSES
+# =============================================================================
+class EntityOutputHook(AutoUnload):
+    """Decorator class used to register entity output callbacks.
+
+    Unlike :class:`listeners.OnEntityOutput`, the callback is only called
+    for the given output and entities. All other outputs are filtered
+    without entering Python.
+
+    The callback receives the same arguments as an
+    :class:`listeners.OnEntityOutput` callback. Return
+    :attr:`events.hooks.EventAction.BLOCK` to block the output.
+
+    Example:
+
+    .. code:: python
+
+        from entities.outputs import EntityOutputHook
+        from events.hooks import EventAction
+
+        @EntityOutputHook('OnStartTouch', classname='trigger_multiple')
+        def on_start_touch(output_name, activator, caller, value, delay):
+            return EventAction.BLOCK
+    """
+
+    def __init__(self, output_name, classname=None, target_name=None):
+        """Store the filter.
+
+        :param str output_name:
+            Name of the output.
+        :param str classname:
+            If given, only outputs of entities with this classname are
+            passed to the callback.
+        :param str target_name:
+            If given, only outputs of entities with this target name are
+            passed to the callback.
+        """
+        self.output_name = output_name
+        self.classname = classname
+        self.target_name = target_name
+        self.callback = None
+
+    def __call__(self, callback):
+        """Register the callback.
+
+        :param callable callback:
+            The callback to register.
+        :return:
+            The passed callback.
+        :rtype: callable
+        """
+        self.callback = callback
+        entity_output_registry.register(
+            self.callback, self.output_name, self.classname, self.target_name)
+
+        return self.callback
+
+    def _unload_instance(self):
+        """Unregister the callback."""
+        if self.callback is None:
+            return
+
+        entity_output_registry.unregister(
+            self.callback, self.output_name, self.classname, self.target_name)
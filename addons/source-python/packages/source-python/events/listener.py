@@ -6,6 +6,8 @@
 # >> IMPORTS
 # =============================================================================
 # Source.Python Imports
+#   Core
+from core.metrics import CounterMetric
 #   Hooks
 from hooks.exceptions import except_hooks
 #   Loggers
@@ -33,6 +35,9 @@ __all__ = ('GameEventListener',
 # Get the sp.events.listener logger
 events_listener_logger = _sp_logger.events.listener
 
+# Built-in metric that counts the called event callbacks
+_event_callback_calls = CounterMetric('sp_event_callback_calls_total')
+
 
 # =============================================================================
 # >> CLASSES
@@ -85,6 +90,8 @@ class _EventListener(list):
         # Loop through each callback in the event's list
         for callback in self:
 
+            _event_callback_calls.increment()
+
             # Try to call the callback
             try:
 
@@ -50,20 +50,19 @@ class RecipientFilter(_RecipientFilter):
         # Return the index at the given recipient slot
         return self.get_recipient_index[item]
 
-    def __iter__(self):
-        """Iterate over the recipient filter."""
-        # Loop through each index in the filter
-        for index in range(len(self)):
-
-            # Yield the recipient
-            yield self.get_recipient_index(index)
-
     def __repr__(self):
         """Return a readable representation of the recipient filter."""
         return '({0})'.format(', '.join(map(str, self)))
 
     def merge(self, iterable):
         """Merge the given recipient."""
+        # Is the given recipient another recipient filter?
+        if isinstance(iterable, _RecipientFilter):
+
+            # Merge the bits at once
+            self.union_update(iterable)
+            return
+
         # Loop through all indexes of the given recipient
         for index in iterable:
 
@@ -14,7 +14,6 @@ from urllib.error import URLError
 #   Core
 from core import AutoUnload
 from core import SOURCE_ENGINE
-from core import PLATFORM
 from core.settings import _core_settings
 from core.version import get_last_successful_build_number
 from core.version import is_unversioned
@@ -25,9 +24,9 @@ from cvars import cvar
 #   Engines
 from engines.server import server_game_dll
 #   Entities
-from entities import BaseEntityOutput
 from entities.datamaps import Variant
-from entities.helpers import find_output_name
+#   Hooks
+from hooks.exceptions import except_hooks
 #   Memory
 from memory import get_virtual_function
 #   Players
@@ -71,9 +70,12 @@ from _listeners import on_data_unloaded_listener_manager
 from _listeners import on_query_cvar_value_finished_listener_manager
 from _listeners import on_server_activate_listener_manager
 from _listeners import on_tick_listener_manager
+from _listeners import on_tick_budget_exceeded_listener_manager
 from _listeners import on_server_output_listener_manager
 from _listeners import on_player_run_command_listener_manager
 from _listeners import on_button_state_changed_listener_manager
+#   Entities
+from _entities._outputs import entity_output_registry
 
 
 # =============================================================================
@@ -117,6 +119,7 @@ __all__ = ('ButtonStatus',
            'OnQueryCvarValueFinished',
            'OnServerActivate',
            'OnTick',
+           'OnTickBudgetExceeded',
            'OnVersionUpdate',
            'OnServerOutput',
            'get_button_combination_status',
@@ -152,6 +155,7 @@ __all__ = ('ButtonStatus',
            'on_query_cvar_value_finished_listener_manager',
            'on_server_activate_listener_manager',
            'on_tick_listener_manager',
+           'on_tick_budget_exceeded_listener_manager',
            'on_version_update_listener_manager',
            'on_server_output_listener_manager',
            'on_player_run_command_listener_manager',
@@ -300,27 +304,12 @@ class OnEntityOutputListenerManager(ListenerManager):
 
     def initialize(self):
         """Called when the first callback is being registered."""
-        # Get the fire_output method
-        fire_output = BaseEntityOutput.fire_output
-
-        # If the fire_output method is not implemented, exit the call
-        if fire_output is NotImplemented:
-            return
-
-        # Register the hook on fire_output
-        fire_output.add_pre_hook(_pre_fire_output)
+        # Listen to all outputs
+        entity_output_registry.register(self.notify)
 
     def finalize(self):
         """Called when the last callback is being unregistered."""
-        # Get the fire_output method
-        fire_output = BaseEntityOutput.fire_output
-
-        # If the fire_output method is not implemented, exit the call
-        if fire_output is NotImplemented:
-            return
-
-        # Unregister the hook on fire_output
-        fire_output.remove_pre_hook(_pre_fire_output)
+        entity_output_registry.unregister(self.notify)
 
 on_entity_output_listener_manager = OnEntityOutputListenerManager()
 
@@ -445,6 +434,18 @@ class OnTick(ListenerManagerDecorator):
     manager = on_tick_listener_manager
 
 
+class OnTickBudgetExceeded(ListenerManagerDecorator):
+    """Register/unregister a tick budget exceeded listener.
+
+    The listener is called with the milliseconds Source.Python has spent in
+    the previous frame and a dictionary with the milliseconds per subsystem.
+
+    .. seealso:: :attr:`core.profiler.frame_budget`
+    """
+
+    manager = on_tick_budget_exceeded_listener_manager
+
+
 class OnVersionUpdate(ListenerManagerDecorator):
     """Register/unregister a version update listener."""
 
@@ -608,45 +609,45 @@ def _pre_call_global_change_callbacks(args):
     on_convar_changed_listener_manager.notify(convar, old_value)
 
 
-def _pre_fire_output(args):
-    """Called when an output is about to be fired."""
-    if not on_entity_output_listener_manager:
-        return
-
-    # Windows is a bit weird: the function takes 4 additional arguments...
-    if PLATFORM == 'windows':
-        args = (args[0],) + tuple(args)[5:]
-
-    caller_ptr = args[3]
-    if not caller_ptr:
-        # If we don't know the caller, we won't be able to retrieve the
-        # output name
-        return
+def _dispatch_entity_output(
+        callbacks, output_name, activator_ptr, caller_ptr, value_ptr, delay):
+    """Called by the entity output registry when a registered output is
+    about to be fired.
 
+    :return:
+        Return ``True`` to block the output.
+    :rtype: bool
+    """
     # Done here to fix cyclic import...
     from entities.entity import BaseEntity
-    caller = make_object(BaseEntity, caller_ptr)
-    output_name = find_output_name(caller, args[0])
-    if output_name is None:
-        return None
-
-    # Done here to fix cyclic import...
     from entities.entity import Entity
+    from events.hooks import EventAction
+
+    caller = make_object(BaseEntity, caller_ptr)
     if caller.is_networked():
         caller = make_object(Entity, caller_ptr)
 
-    value_ptr = args[1]
     value = (value_ptr or None) and make_object(Variant, value_ptr)
 
-    activator_ptr = args[2]
     activator = ((activator_ptr or None) and make_object(
         BaseEntity, activator_ptr))
     if activator is not None and activator.is_networked():
         activator = make_object(Entity, activator_ptr)
 
-    delay = args[4]
-    on_entity_output_listener_manager.notify(
-        output_name, activator, caller, value, delay)
+    action = EventAction.CONTINUE
+    for callback in callbacks:
+        try:
+            result = callback(output_name, activator, caller, value, delay)
+        except:
+            except_hooks.print_exception()
+            continue
+
+        if result is not None and result > action:
+            action = result
+
+    return action == EventAction.BLOCK
+
+entity_output_registry.dispatcher = _dispatch_entity_output
 
 
 # ============================================================================
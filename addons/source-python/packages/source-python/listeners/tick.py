@@ -18,6 +18,7 @@ from warnings import warn
 # Source.Python
 from core import AutoUnload
 from core import WeakAutoUnload
+from core.metrics import GaugeMetric
 from hooks.exceptions import except_hooks
 from listeners import (
     listeners_logger, on_tick_listener_manager, OnLevelEnd,
@@ -41,6 +42,9 @@ __all__ = (
 # Get the sp.listeners.tick logger
 listeners_tick_logger = listeners_logger.tick
 
+# Number of pending delays
+_delay_queue_depth = GaugeMetric('sp_delay_queue_depth')
+
 
 # =============================================================================
 # >> THREAD WORKAROUND
@@ -81,6 +85,8 @@ class _DelayManager(list):
             except:
                 except_hooks.print_exception()
 
+        _delay_queue_depth.set(len(self))
+
     def add(self, delay):
         """Add a delay to the list.
 
@@ -6,6 +6,8 @@
 # >> IMPORTS
 # =============================================================================
 # Python Imports
+#   Codecs
+from codecs import lookup
 #   Datetime
 from datetime import date
 #   Logging
@@ -18,10 +20,13 @@ from logging import FileHandler
 from logging import Formatter
 from logging import addLevelName
 from logging import getLogger
+#   Sys
+import sys
 
 # Source.Python Imports
 #   Core
 from core import AutoUnload
+from _core._log import log_sink
 #   Cvars
 from cvars import ConVar
 #   Paths
@@ -249,13 +254,14 @@ class _LogInstance(dict):
         if SCRIPT_LOG & areas and self.root != _sp_logger:
 
             # Print message to the log file
-            self.logger.log(level, msg, *args, **kwargs)
+            self.root._write_record(self.logger, level, msg, args, kwargs)
 
         # Print to the main SP log file?
         if SP_LOG & areas:
 
             # Print to the SP log file
-            _sp_logger.logger.log(level, msg, *args, **kwargs)
+            _sp_logger._write_record(
+                _sp_logger.logger, level, msg, args, kwargs)
 
     @staticmethod
     def _get_level_value(level):
@@ -351,6 +357,9 @@ class LogManager(AutoUnload, _LogInstance):
         # Create the logger
         self._logger = getLogger(name)
 
+        # Identifier of the file the log sink writes to
+        self._log_file = None
+
         # Was a filepath given?
         if filepath is not None:
 
@@ -369,10 +378,54 @@ class LogManager(AutoUnload, _LogInstance):
                 # Create the parent directory
                 log_path.parent.makedirs()
 
-            # Create the handler an add it to the logger
-            self._handler = FileHandler(log_path, encoding=encoding)
-            self._handler.setFormatter(self.formatter)
-            self.logger.addHandler(self._handler)
+            # The log sink writes UTF-8 encoded records from a background
+            #   thread, so the game thread doesn't wait for the disk
+            if lookup(encoding).name == 'utf-8':
+                self._log_file = log_sink.open(str(log_path))
+
+            # Otherwise, create the handler an add it to the logger
+            else:
+                self._handler = FileHandler(log_path, encoding=encoding)
+                self._handler.setFormatter(self.formatter)
+                self.logger.addHandler(self._handler)
+
+    def _write_record(self, logger, level, msg, args, kwargs):
+        """Write a record to the log file of this instance.
+
+        :param logging.Logger logger:
+            The logger that is used to create the record.
+        :param int level:
+            The level of the message.
+        :param str msg:
+            Message to log.
+        :param tuple args:
+            Additional arguments that are used for formatting purpose.
+        :param dict kwargs:
+            Additional keywords that are used for formatting purpose.
+        """
+        # Is a FileHandler used for this log file?
+        if self._log_file is None:
+            logger.log(level, msg, *args, **kwargs)
+            return
+
+        # Get the exception information like Logger.log would do
+        exc_info = kwargs.get('exc_info')
+        if isinstance(exc_info, BaseException):
+            exc_info = (type(exc_info), exc_info, exc_info.__traceback__)
+        elif exc_info and not isinstance(exc_info, tuple):
+            exc_info = sys.exc_info()
+
+        # Create the record
+        record = logger.makeRecord(
+            logger.name, level, '(unknown file)', 0, msg, args, exc_info,
+            extra=kwargs.get('extra'))
+
+        # Queue the record to be written by the log sink
+        log_sink.write(self._log_file, self.formatter.format(record) + '\n')
+
+        # Pass the record to custom handlers
+        if logger.hasHandlers():
+            logger.handle(record)
 
     @property
     def level(self):
@@ -394,6 +447,11 @@ class LogManager(AutoUnload, _LogInstance):
         """Remove the logger from logging manager."""
         self.logger.manager.loggerDict.pop(self.logger.name, None)
 
+        # Write all queued records and close the log file
+        if self._log_file is not None:
+            log_sink.close(self._log_file)
+            self._log_file = None
+
 # Set the core ConVars
 _level = ConVar(
     'sp_logging_level', '0', 'The Source.Python base logging level')
@@ -20,6 +20,7 @@ from loggers import _sp_logger
 #   core
 from core import AutoUnload
 #   memory
+from _memory import ArrayView
 from _memory import BinaryFile
 from _memory import CallingConvention
 from _memory import CLASS_INFO
@@ -46,7 +47,8 @@ from _memory import make_object
 # =============================================================================
 # >> ALL DECLARATION
 # =============================================================================
-__all__ = ('BinaryFile',
+__all__ = ('ArrayView',
+           'BinaryFile',
            'CLASS_INFO',
            'Callback',
            'CallingConvention',
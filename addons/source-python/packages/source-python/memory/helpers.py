@@ -13,6 +13,7 @@ import binascii
 #   Core
 from core import PLATFORM
 #   Memory
+from memory import ArrayView
 from memory import Convention
 from memory import DataType
 from memory import Function
@@ -221,15 +222,44 @@ class Array(BasePointer):
         # Optional -- specifies the length of the array
         self._length = length
 
+        # Native view of the array. Created on first access.
+        self._view = None
+
         super().__init__(ptr)
 
     def __getitem__(self, index):
-        """Return the value at the given index."""
-        return self._make_attribute(index).__get__(self)
+        """Return the value at the given index.
+
+        If the array contains native values or pointers to custom types,
+        a slice can be passed to retrieve a list of values.
+        """
+        view = self._get_view()
+        if view is None:
+            # Instances of custom types are located every x bytes
+            if not self._is_ptr and not Type.is_native(self._type_name):
+                self._validate_index(index)
+                return self._manager.convert(
+                    self._type_name, self + self.get_offset(index))
+
+            return self._make_attribute(index).__get__(self)
+
+        # Native values don't need to be converted
+        if not self._is_ptr:
+            return view[index]
+
+        if isinstance(index, slice):
+            return [self._manager.convert(
+                self._type_name, ptr) for ptr in view[index]]
+
+        return self._manager.convert(self._type_name, view[index])
 
     def __setitem__(self, index, value):
         """Set the value at the given index."""
-        self._make_attribute(index).__set__(self, value)
+        view = self._get_view()
+        if view is not None and not self._is_ptr:
+            view[index] = value
+        else:
+            self._make_attribute(index).__set__(self, value)
 
     def __iter__(self):
         """Return a generator that can iterate over the array."""
@@ -240,15 +270,60 @@ class Array(BasePointer):
                 'Cannot iterate over the array without _length being specif' +
                 'ied.')
 
-        for index in range(self._length):
-            yield self[index]
+        yield from self.tolist()
 
-    def _make_attribute(self, index):
-        """Validate the index and returns a new property object."""
-        # Validate the index, so we don't access invalid memory addresses
+    def tolist(self):
+        """Return all values of the array as a list.
+
+        :raise ValueError: Raised if the length of the array is unknown.
+        :rtype: list
+        """
+        if self._length is None:
+            raise ValueError(
+                'Cannot convert the array without _length being specified.')
+
+        if self._get_view() is not None:
+            return self[:]
+
+        return [self[index] for index in range(self._length)]
+
+    def _get_view(self):
+        """Return the native view of the array.
+
+        Return None if the array has to be accessed through properties.
+
+        :rtype: ArrayView
+        """
+        if self._view is not None:
+            return self._view
+
+        type_name = self._type_name.upper()
+        if self._is_ptr:
+            # Pointers to custom types are converted after reading them
+            if Type.is_native(self._type_name):
+                return None
+
+            data_type = DataType.POINTER
+
+        # Strings don't have a fixed size
+        elif Type.is_native(self._type_name) and type_name in TYPE_SIZES:
+            data_type = getattr(DataType, type_name)
+
+        else:
+            return None
+
+        self._view = ArrayView(self, data_type, self._length)
+        return self._view
+
+    def _validate_index(self, index):
+        """Validate the index, so we don't access invalid memory addresses."""
         if self._length is not None and index >= self._length:
             raise IndexError('Index out of range')
 
+    def _make_attribute(self, index):
+        """Validate the index and returns a new property object."""
+        self._validate_index(index)
+
         # Construct the proper function name
         name = ('pointer' if self._is_ptr else 'instance') + '_attribute'
 
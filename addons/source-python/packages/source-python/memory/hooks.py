@@ -12,6 +12,10 @@ from contextlib import contextmanager
 #   Core
 from core import AutoUnload
 #   Memory
+from _memory import HookFilter
+from _memory import HookRule
+from _memory import HookRuleAction
+from _memory import HookRuleOperator
 from _memory import HookType
 from _memory import set_hooks_disabled
 from _memory import get_hooks_disabled
@@ -21,9 +25,15 @@ from memory import Function
 # =============================================================================
 # >> ALL DECLARATION
 # =============================================================================
-__all__ = ('HookType',
+__all__ = ('HookFilter',
+           'HookRule',
+           'HookRuleAction',
+           'HookRuleOperator',
+           'HookType',
            'PostHook',
+           'PostHookRule',
            'PreHook',
+           'PreHookRule',
            'set_hooks_disabled',
            'get_hooks_disabled',
            'hooks_disabled',
@@ -37,8 +47,15 @@ __all__ = ('HookType',
 class _Hook(AutoUnload):
     """Create pre and post hooks that auto unload."""
 
-    def __init__(self, function):
-        """Verify the given function is a Function object and store it."""
+    def __init__(self, function, hook_filter=None):
+        """Verify the given function is a Function object and store it.
+
+        :param Function function:
+            The function to hook.
+        :param HookFilter hook_filter:
+            If given, the callback is only called if the filter accepts the
+            first argument of the function.
+        """
         # Is the function to be hooked a Function instance?
         if not isinstance(function, Function):
 
@@ -50,6 +67,7 @@ class _Hook(AutoUnload):
         # Store the function
         self.callback = None
         self.function = function
+        self.hook_filter = hook_filter
 
     def __call__(self, callback):
         """Store the callback and hook it."""
@@ -57,7 +75,8 @@ class _Hook(AutoUnload):
         self.callback = callback
 
         # Hook the callback to the Function
-        self.function.add_hook(self.hook_type, self.callback)
+        self.function.add_hook(
+            self.hook_type, self.callback, self.hook_filter)
 
         # Return the callback
         return self.callback
@@ -84,6 +103,63 @@ class PostHook(_Hook):
     hook_type = HookType.POST
 
 
+class _HookRule(AutoUnload):
+    """Register a hook rule that auto unloads."""
+
+    def __init__(self, function, rule):
+        """Register the rule.
+
+        :param Function function:
+            The function the rule is added to.
+        :param HookRule rule:
+            The rule to add.
+        """
+        if not isinstance(function, Function):
+            raise TypeError(
+                "'" + type(function).__name__ +
+                "' object is not a Function instance.")
+
+        self.function = function
+        self.rule = rule
+        self.function.add_hook_rule(self.hook_type, self.rule)
+
+    @property
+    def hook_type(self):
+        """Raise an error if the inheriting class does not have their own."""
+        raise NotImplementedError('No hook_type defined for class.')
+
+    def _unload_instance(self):
+        """Remove the rule on script unload."""
+        self.function.remove_hook_rule(self.hook_type, self.rule)
+
+
+class PreHookRule(_HookRule):
+    """Register a pre-hook rule that auto unloads.
+
+    Example:
+
+    .. code:: python
+
+        from memory.hooks import HookRule
+        from memory.hooks import HookRuleAction
+        from memory.hooks import HookRuleOperator
+        from memory.hooks import PreHookRule
+
+        # Block the function if the second argument is 0
+        rule = HookRule(HookRuleAction.RETURN, False)
+        rule.add_condition(1, HookRuleOperator.EQUAL, 0)
+        PreHookRule(function, rule)
+    """
+
+    hook_type = HookType.PRE
+
+
+class PostHookRule(_HookRule):
+    """Register a post-hook rule that auto unloads."""
+
+    hook_type = HookType.POST
+
+
 # =============================================================================
 # >> FUNCTIONS
 # =============================================================================
@@ -7,7 +7,8 @@
 # =============================================================================
 # Source.Python Imports
 #   Core
-from core import GameConfigObj
+from core import get_game_data
+from core.profiler import startup_profiler
 #   Memory
 from memory import Convention
 from memory import DataType
@@ -293,7 +294,7 @@ class TypeManager(dict):
 
     def create_pipe_from_file(self, f):
         """Create a pipe from a file or URL."""
-        return self.create_pipe_from_dict(GameConfigObj(f))
+        return self.create_pipe_from_dict(get_game_data(f))
 
     def create_pipe_from_dict(self, raw_data):
         """Create a pipe from a dictionary."""
@@ -315,7 +316,8 @@ class TypeManager(dict):
         # Create the functions
         cls_dict = {}
         for name, data in funcs:
-            cls_dict[name] = self.pipe_function(*data)
+            with startup_profiler.section('pipe function ' + name):
+                cls_dict[name] = self.pipe_function(*data)
 
         return self.create_pipe(cls_dict)
 
@@ -340,7 +342,7 @@ class TypeManager(dict):
     def create_type_from_file(self, type_name, f, bases=(CustomType,)):
         """Create and registers a new type from a file or URL."""
         return self.create_type_from_dict(
-            type_name, GameConfigObj(f), bases)
+            type_name, get_game_data(f), bases)
 
     def create_type_from_dict(self, type_name, raw_data, bases=(CustomType,)):
         """Create and registers a new type from a dictionary."""
@@ -697,7 +699,7 @@ class TypeManager(dict):
     def create_function_typedefs_from_file(self, f):
         """Create function typedefs from a file."""
         # Read the data
-        raw_data = GameConfigObj(f)
+        raw_data = get_game_data(f)
 
         # Prepare typedefs
         typedefs = parse_data(
@@ -721,11 +723,12 @@ class TypeManager(dict):
         manager_logger.log_debug(
             'Retrieving global pointer for {}...'.format(cls.__name__))
 
-        # Get the binary
-        binary = find_binary(binary, srv_check)
+        with startup_profiler.section('global pointer ' + cls.__name__):
+            # Get the binary
+            binary = find_binary(binary, srv_check)
 
-        # Get the global pointer
-        ptr = binary.find_pointer(identifier, offset, level)
+            # Get the global pointer
+            ptr = binary.find_pointer(identifier, offset, level)
 
         # Raise an error if the pointer is invalid
         if not ptr:
@@ -740,7 +743,7 @@ class TypeManager(dict):
         # Parse pointer data
         pointers = parse_data(
             self,
-            GameConfigObj(f),
+            get_game_data(f),
             (
                 (Key.BINARY, Key.as_str, NO_DEFAULT),
                 (Key.IDENTIFIER, Key.as_identifier, NO_DEFAULT),
@@ -10,12 +10,16 @@
 from collections import defaultdict
 #   Math
 import math
+#   Time
+import time
 #   Weakref
 from weakref import WeakValueDictionary
 
 # Source.Python Imports
 #   Core
 from core import WeakAutoUnload
+#   Engines
+from engines.server import global_vars
 #   Filters
 from filters.recipients import RecipientFilter
 #   Listeners
@@ -38,6 +42,66 @@ class _PlayerPage(object):
         self.options = {}
 
 
+class _DisplayState(object):
+    """Stores which menu data was sent to a player and until when it is shown.
+
+    Used by the menu queues to skip re-sending a menu the player is still
+    seeing with the same content.
+    """
+
+    def __init__(self):
+        """Initialize the object."""
+        self.reset()
+
+    def reset(self):
+        """Forget the displayed menu, so the next refresh will send it."""
+        self.menu = None
+        self.data_hash = None
+        self.expire_time = 0
+
+    def is_displayed(self, menu, data_hash):
+        """Return True if the given menu data is still displayed.
+
+        :param _BaseMenu menu: The menu to check.
+        :param data_hash: The hash of the menu data or None if the menu data
+            can't be hashed.
+        :rtype: bool
+        """
+        if data_hash is None or self.menu is not menu:
+            return False
+
+        if self.data_hash != data_hash:
+            return False
+
+        return self.expire_time is None or time.time() < self.expire_time
+
+    def update(self, menu, data_hash, display_time):
+        """Store the menu data that has been sent to the player.
+
+        :param _BaseMenu menu: The menu that has been sent.
+        :param data_hash: The hash of the sent menu data.
+        :param float display_time: The number of seconds the menu is
+            displayed. A value lower than or equal to 0 means forever.
+        """
+        self.menu = menu
+        self.data_hash = data_hash
+        # Re-send the menu one tick before it expires
+        self.expire_time = (
+            None if display_time <= 0 else
+            time.time() + display_time - global_vars.interval_per_tick)
+
+    @property
+    def time_remaining(self):
+        """Return the seconds until the menu needs to be sent again.
+
+        :rtype: float|None
+        """
+        if self.expire_time is None:
+            return None
+
+        return max(self.expire_time - time.time(), 0)
+
+
 class _BaseMenu(WeakAutoUnload, list):
     """The base menu. Every menu class should inherit from this class."""
 
@@ -95,13 +159,25 @@ class _BaseMenu(WeakAutoUnload, list):
         """
         self._player_pages.pop(player_index, 0)
 
-    def _refresh(self, player_index):
-        """Re-send the menu to a player.
+    def _refresh(self, player_index, state):
+        """Re-send the menu to a player if its content has changed or the
+        displayed menu is about to expire.
 
         :param int player_index: The index of the player whose menu should be
             refreshed.
+        :param _DisplayState state: The player's current display state.
+        :return: The seconds until the menu needs to be refreshed again or
+            None if it doesn't expire.
+        :rtype: float|None
         """
-        self._send(player_index)
+        data = self._build(player_index)
+        data_hash = self._hash_menu_data(data)
+
+        if not state.is_displayed(self, data_hash):
+            self._send_menu_data(player_index, data)
+            state.update(self, data_hash, self._get_display_time(data))
+
+        return state.time_remaining
 
     def _build(self, player_index):
         """Call the build callback and return all relevant menu data.
@@ -171,7 +247,10 @@ class _BaseMenu(WeakAutoUnload, list):
         for player_index in ply_indexes:
             queue = self.get_user_queue(player_index)
             queue.append(self)
-            queue._refresh()
+
+            # Send it again, even if the player already received this
+            # content, because the menu might have been closed or hidden
+            queue._refresh(force=True)
 
     def close(self, *ply_indexes):
         """Close the menu for the given player indexes.
@@ -195,10 +274,9 @@ class _BaseMenu(WeakAutoUnload, list):
                     # Send an empty menu
                     self._close(player_index)
 
-                else:
-                    # There is at least one menu in the queue, so refresh to
-                    # display it.
-                    queue._refresh()
+                # Refresh to display the next menu or to stop refreshing if
+                # there is no menu left.
+                queue._refresh(force=True)
 
     def is_active_menu(self, player_index):
         """Return True if this menu is the first menu in the user's queue.
@@ -233,11 +311,39 @@ class _BaseMenu(WeakAutoUnload, list):
         raise NotImplementedError
 
     def _send(self, player_index):
-        """Send a menu to the player.
+        """Build and send a menu to the player.
+
+        :param int player_index: A player index.
+        """
+        self._send_menu_data(player_index, self._build(player_index))
+
+    def _send_menu_data(self, player_index, data):
+        """Send already built menu data to the player.
 
         This method needs to be implemented by a subclass!
 
         :param int player_index: A player index.
+        :param data: The data returned by :meth:`_get_menu_data`.
+        """
+        raise NotImplementedError
+
+    @staticmethod
+    def _hash_menu_data(data):
+        """Return a hash of the given menu data.
+
+        If None is returned, the menu will be re-sent on every refresh.
+
+        :param data: The data returned by :meth:`_get_menu_data`.
+        """
+        return None
+
+    @staticmethod
+    def _get_display_time(data):
+        """Return the number of seconds the given menu data is displayed.
+
+        This method needs to be implemented by a subclass!
+
+        :param data: The data returned by :meth:`_get_menu_data`.
         """
         raise NotImplementedError
 
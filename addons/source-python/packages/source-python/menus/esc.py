@@ -41,6 +41,9 @@ __all__ = ('ListESCMenu',
 # =============================================================================
 VALID_CHOICES = range(8)
 
+# Number of seconds a menu is displayed before it needs to be sent again
+MENU_DISPLAY_TIME = 10
+
 
 # =============================================================================
 # >> CLASSES
@@ -119,20 +122,20 @@ class SimpleESCMenu(_BaseMenu):
 
         return super()._select(player_index, option)
 
-    def _send(self, player_index):
-        """Build and send the menu to the given player via create_message().
+    def _send_menu_data(self, player_index, data):
+        """Send the menu data to the given player via create_message().
 
-        :param int player_index: See :meth:`menus.base._BaseMenu._send`.
+        :param int player_index: See
+            :meth:`menus.base._BaseMenu._send_menu_data`.
+        :param KeyValues data: See
+            :meth:`menus.base._BaseMenu._send_menu_data`.
         """
         queue = self.get_user_queue(player_index)
         queue.priority -= 1
 
-        # Build the menu
-        data = self._build(player_index)
-
         # Set priority and display time
         data.set_int('level', queue.priority)
-        data.set_int('time', 10)
+        data.set_int('time', MENU_DISPLAY_TIME)
 
         # Send the menu
         create_message(
@@ -141,6 +144,16 @@ class SimpleESCMenu(_BaseMenu):
             data
         )
 
+    @staticmethod
+    def _hash_menu_data(data):
+        """See :meth:`menus.base._BaseMenu._hash_menu_data`."""
+        return hash(str(data.as_dict()))
+
+    @staticmethod
+    def _get_display_time(data):
+        """See :meth:`menus.base._BaseMenu._get_display_time`."""
+        return MENU_DISPLAY_TIME
+
     def _close(self, player_index):
         """See :meth:`menus.base._BaseMenu._close`."""
         queue = self.get_user_queue(player_index)
@@ -150,7 +163,7 @@ class SimpleESCMenu(_BaseMenu):
         data = KeyValues('menu')
         data.set_string('title', '')
         data.set_int('level', queue.priority)
-        data.set_int('time', 10)
+        data.set_int('time', MENU_DISPLAY_TIME)
         data.set_string('msg', '')
         create_message(edict_from_index(player_index), DialogType.MENU, data)
 
@@ -15,9 +15,10 @@ from commands import CommandReturn
 from commands.client import ClientCommand
 #   Listeners
 from listeners import OnClientDisconnect
-from listeners.tick import Repeat
+from listeners.tick import Delay
 #   Menus
 from menus.base import _BaseMenu
+from menus.base import _DisplayState
 
 
 # =============================================================================
@@ -26,6 +27,9 @@ from menus.base import _BaseMenu
 # The name of the client command that used for ESC menus
 ESC_SELECTION_CMD = 'escselect'
 
+# Number of seconds until a menu is built again after its build failed
+_RETRY_INTERVAL = 1
+
 
 # =============================================================================
 # >> CLASSES
@@ -43,6 +47,8 @@ class _UserQueue(deque):
         """
         super().__init__()
         self._index = index
+        self._display_state = _DisplayState()
+        self._refresh_delay = None
 
     def append(self, menu):
         """Add a menu to the end of the queue.
@@ -95,14 +101,39 @@ class _UserQueue(deque):
         if menu not in self:
             super().__setitem__(index, menu)
 
-    def _refresh(self):
-        """Re-send the current active menu.
+    def _refresh(self, force=False):
+        """Re-send the current active menu if it has changed or expires.
+
+        Afterwards the next refresh will be scheduled for the time the menu
+        expires. If there is no active menu or the menu doesn't expire, no
+        refresh will be scheduled.
 
-        If there is no active menu, nothing will be done.
+        :param bool force: If True, the menu will be sent even if the player
+            is still seeing the same content.
         """
+        self._cancel_refresh()
+        if force:
+            self._display_state.reset()
+
         menu = self.active_menu
-        if menu is not None:
-            menu._refresh(self._index)
+        if menu is None:
+            self._display_state.reset()
+            return
+
+        remaining = _RETRY_INTERVAL
+        try:
+            remaining = menu._refresh(self._index, self._display_state)
+        finally:
+            # Keep refreshing, even if the menu failed to build
+            if remaining is not None:
+                self._refresh_delay = Delay(remaining, self._refresh)
+
+    def _cancel_refresh(self):
+        """Cancel the scheduled refresh."""
+        if self._refresh_delay is not None and self._refresh_delay.running:
+            self._refresh_delay.cancel()
+
+        self._refresh_delay = None
 
     def _select(self, choice):
         """Handle a menu selection.
@@ -136,11 +167,11 @@ class _UserQueue(deque):
 
             # If the queue belongs to a different queue, refresh that queue.
             if self is not queue:
-                queue._refresh()
+                queue._refresh(force=True)
 
-        # Always refresh this queue if the queue is not empty
-        if self:
-            self._refresh()
+        # The client hides the menu after a selection, so always send the
+        # next menu. This also stops the refresh if the queue is empty.
+        self._refresh(force=True)
 
     @property
     def active_menu(self):
@@ -168,28 +199,19 @@ class _ESCUserQueue(_UserQueue):
 class _QueueHolder(dict):
     """Creates a _UserQueue object for every missing key."""
 
-    def __init__(self, cls, repeat):
+    def __init__(self, cls):
         """Initialize the queue holder.
 
         :param _UserQueue cls: The queue to hold.
-        :param repeat: Global refresh repeat object.
-        :type repeat: :class:`listeners.tick.Repeat`
         """
         super().__init__()
         self._cls = cls
-        self._repeat = repeat
 
     def __missing__(self, index):
         """Create a new _UserQueue object for the given index.
 
         :param int index: A player index.
         """
-        # Is the dictionary currently empty?
-        if not self:
-
-            # If so, start the refresh repeat...
-            self._repeat.start(1)
-
         obj = self[index] = self._cls(index)
         return obj
 
@@ -197,11 +219,9 @@ class _QueueHolder(dict):
         """Remove and return the given key's value."""
         return_value = super().pop(key, default)
 
-        # Is the dictionary currently empty?
-        if not self:
-
-            # If so, stop the refresh repeat...
-            self._repeat.stop()
+        # Stop refreshing the removed queue
+        if isinstance(return_value, _UserQueue):
+            return_value._cancel_refresh()
 
         # Return the popped key's value...
         return return_value
@@ -229,29 +249,12 @@ def _validate_selection(command, index, valid_choices):
     return (None, None)
 
 
-# =============================================================================
-# >> REPEATS
-# =============================================================================
-@Repeat
-def _radio_refresh():
-    """Update every queue in the queue dict."""
-    for queue in _radio_queues.values():
-        queue._refresh()
-
-
-@Repeat
-def _esc_refresh():
-    """Update every queue in the queue dict."""
-    for queue in _esc_queues.values():
-        queue._refresh()
-
-
 # =============================================================================
 # >> GLOBAL VARIABLES
 # =============================================================================
 # {<user index>: <_UserQueue>}
-_radio_queues = _QueueHolder(_UserQueue, _radio_refresh)
-_esc_queues = _QueueHolder(_ESCUserQueue, _esc_refresh)
+_radio_queues = _QueueHolder(_UserQueue)
+_esc_queues = _QueueHolder(_ESCUserQueue)
 
 
 # =============================================================================
@@ -112,12 +112,25 @@ class SimpleRadioMenu(_BaseMenu):
             player_index,
             self._player_pages[player_index].options[choice_index])
 
-    def _send(self, player_index):
-        """Build and sends the menu to the given player via ShowMenu.
+    @staticmethod
+    def _send_menu_data(player_index, data):
+        """Send the menu data to the given player via ShowMenu.
 
-        :param int player_index: See :meth:`menus.base._BaseMenu._send`.
+        :param int player_index: See
+            :meth:`menus.base._BaseMenu._send_menu_data`.
+        :param tuple data: See :meth:`menus.base._BaseMenu._send_menu_data`.
         """
-        ShowMenu(*self._build(player_index)).send(player_index)
+        ShowMenu(*data).send(player_index)
+
+    @staticmethod
+    def _hash_menu_data(data):
+        """See :meth:`menus.base._BaseMenu._hash_menu_data`."""
+        return hash(data)
+
+    @staticmethod
+    def _get_display_time(data):
+        """See :meth:`menus.base._BaseMenu._get_display_time`."""
+        return data[2]
 
     @staticmethod
     def _close(player_index):
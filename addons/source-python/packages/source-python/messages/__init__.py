@@ -22,6 +22,7 @@ from messages.base import Fade
 from messages.base import HudMsg
 from messages.base import UserMessageCreator
 from messages.base import UserMessage
+from messages.base import UserMessageData
 from messages.dialog import DialogAskConnect
 from messages.dialog import DialogEntry
 from messages.dialog import DialogMenu
@@ -69,6 +70,7 @@ __all__ = ('DialogAskConnect',
            'TextMsg',
            'UserMessage',
            'UserMessageCreator',
+           'UserMessageData',
            'VGUIMenu',
            )
 
@@ -25,10 +25,33 @@ from translations.strings import TranslationStrings
 # ============================================================================
 #   Messages
 from _messages import UserMessage
+from _messages import UserMessageData
 from _messages import SCREENFADE_FRACBITS
 from _messages import ShakeCommand
 from _messages import HudDestination
 from _messages import FadeFlags
+from _messages import send_show_menu
+
+
+# =============================================================================
+# >> GLOBAL VARIABLES
+# =============================================================================
+# Maximum number of encoded user messages that are kept to be sent again
+_MAX_CACHED_MESSAGES = 512
+
+# Store the encoded user messages by their creator class and arguments
+_message_data_cache = collections.OrderedDict()
+
+
+# =============================================================================
+# >> HELPER FUNCTIONS
+# =============================================================================
+def _is_immutable(value):
+    """Return whether the value can't be changed after it has been cached."""
+    if isinstance(value, tuple):
+        return all(map(_is_immutable, value))
+
+    return value is None or isinstance(value, (str, bytes, int, float))
 
 
 # =============================================================================
@@ -87,28 +110,46 @@ class UserMessageCreator(AttrDict):
         """
         recipients = RecipientFilter(*player_indexes)
         recipients.reliable = self.reliable
-        user_message = UserMessage(recipients, self.message_name)
+        self._get_message_data(translated_kwargs).send(recipients)
 
-        if user_message.is_protobuf():
-            self.protobuf(user_message.buffer, translated_kwargs)
-            user_message.send()
+    def _get_message_data(self, translated_kwargs):
+        """Return the encoded user message for the given arguments.
+
+        If the same arguments have been sent before, the already encoded
+        user message is returned.
+
+        :param AttrDict translated_kwargs: The translated arguments.
+        :rtype: UserMessageData
+        """
+        # Mutable arguments (e.g. Color instances) could be changed after the
+        # message has been cached, so only immutable arguments are cached
+        if all(map(_is_immutable, translated_kwargs.values())):
+            key = (type(self), frozenset(translated_kwargs.items()))
+            data = _message_data_cache.get(key)
+        else:
+            key = data = None
+
+        if data is not None:
+            _message_data_cache.move_to_end(key)
+            return data
+
+        # The data is written into a separate buffer, so an error while
+        # writing it doesn't leave an unfinished user message in the engine.
+        # See also:
+        # https://github.com/Source-Python-Dev-Team/Source.Python/issues/315
+        data = UserMessageData(self.message_name)
+        if UserMessage.is_protobuf():
+            self.protobuf(data.buffer, translated_kwargs)
         else:
-            try:
-                self.bitbuf(user_message.buffer, translated_kwargs)
-            except:
-                # In case of an error during writing to the buffer (e. g. by using
-                # the wrong data type for the write_* methods) reset the buffer
-                # and send the message. This causes the engine to silently ignore
-                # the user message and the server doesn't crash upon creating
-                # another user message.
-                # See also:
-                # https://github.com/Source-Python-Dev-Team/Source.Python/issues/315
-                user_message.buffer.reset()
-
-                # Re-raise the exception to make the user aware of the problem
-                raise
-            finally:
-                user_message.send()
+            self.bitbuf(data.buffer, translated_kwargs)
+
+        # Overflowed data can't be sent, so don't keep it
+        if key is not None and not data.overflowed:
+            _message_data_cache[key] = data
+            if len(_message_data_cache) > _MAX_CACHED_MESSAGES:
+                _message_data_cache.popitem(last=False)
+
+        return data
 
     @staticmethod
     def _categorize_players_by_language(player_indexes):
@@ -221,17 +262,14 @@ class ShowMenu(UserMessageCreator):
 
     def send(self, *player_indexes):
         """Send the user message."""
-        # We need to handle the ShowMenu user message with bitbuffers
-        # differently, because the maximum size is 255. If the message exceeds
-        # this length, we need to sent it in several parts.
-        if UserMessage.is_protobuf():
-            recipients = RecipientFilter(*player_indexes)
-            recipients.reliable = self.reliable
-            user_message = UserMessage(recipients, self.message_name)
-            self.protobuf(user_message.buffer, self)
-            user_message.send()
-        else:
-            self.bitbuf(player_indexes, self)
+        recipients = RecipientFilter(*player_indexes)
+        recipients.reliable = self.reliable
+
+        # With bitbuffers the maximum size of the user message is 255, so
+        # longer menus are sent in several parts.
+        send_show_menu(
+            recipients, self.valid_slots, self.display_time,
+            self.menu_string, self.chunk_size)
 
     def protobuf(self, buffer, kwargs):
         """Send the ShowMenu with protobuf."""
@@ -241,26 +279,11 @@ class ShowMenu(UserMessageCreator):
 
     def bitbuf(self, player_indexes, kwargs):
         """Send the ShowMenu with bitbuf."""
-        menu_string = kwargs.menu_string
-        length = len(menu_string)
         recipients = RecipientFilter(*player_indexes)
         recipients.reliable = self.reliable
-        while True:
-            user_message = UserMessage(recipients, self.message_name)
-
-            buffer = user_message.buffer
-            buffer.write_word(kwargs.valid_slots)
-            buffer.write_char(kwargs.display_time)
-            buffer.write_byte(length > self.chunk_size)
-            buffer.write_string(menu_string[:self.chunk_size])
-
-            user_message.send()
-
-            if length > self.chunk_size:
-                menu_string = menu_string[self.chunk_size:]
-                length -= self.chunk_size
-            else:
-                break
+        send_show_menu(
+            recipients, kwargs.valid_slots, kwargs.display_time,
+            kwargs.menu_string, self.chunk_size)
 
 
 class SayText2(UserMessageCreator):
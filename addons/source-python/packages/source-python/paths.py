@@ -15,6 +15,7 @@ from path import Path
 # =============================================================================
 __all__ = ('ADDONS_PATH',
            'BASE_PATH',
+           'CACHE_PATH',
            'CFG_PATH',
            'CUSTOM_DATA_PATH',
            'CUSTOM_PACKAGES_DOCS_PATH',
@@ -54,6 +55,9 @@ BASE_PATH = ADDONS_PATH / 'source-python'
 # ../addons/source-python/update
 UPDATE_PATH = BASE_PATH / 'update'
 
+# ../addons/source-python/cache
+CACHE_PATH = BASE_PATH / 'cache'
+
 # ../addons/source-python/docs
 DOCS_PATH = BASE_PATH / 'docs'
 
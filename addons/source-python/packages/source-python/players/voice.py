@@ -6,18 +6,11 @@
 # =============================================================================
 # >> IMPORTS
 # =============================================================================
-# Python
-import collections
-
 # Source.Python
 #    Engines
 from engines.server import global_vars
 #    Listeners
 from listeners import OnClientDisconnect
-#    Memory
-import memory
-
-from memory.hooks import PreHook
 
 
 # =============================================================================
@@ -26,6 +19,10 @@ from memory.hooks import PreHook
 # Source.Python Imports
 #  Voice
 from _players._voice import voice_server
+from _players._voice import is_muted
+from _players._voice import mute
+from _players._voice import unmute
+from _players._voice import unmute_sender
 
 
 # =============================================================================
@@ -40,8 +37,12 @@ __all__ = ('_MuteManager',
 # =============================================================================
 # >> CLASSES
 # =============================================================================
-class _MuteManager(collections.defaultdict):
-    """A singleton that manages muting players."""
+class _MuteManager(object):
+    """A singleton that manages muting players.
+
+    The mutes are stored in a native matrix, which is checked by a native
+    hook on IVoiceServer::SetClientListening.
+    """
 
     @staticmethod
     def _get_receivers(receivers):
@@ -76,7 +77,7 @@ class _MuteManager(collections.defaultdict):
         anymore.
         """
         for receiver in self._get_receivers(receivers):
-            self[receiver].add(sender)
+            mute(sender, receiver)
 
     def unmute_player(self, sender, receivers=None):
         """Unmute a player, so other players can hear him again.
@@ -88,8 +89,12 @@ class _MuteManager(collections.defaultdict):
         tuple that contains the player indexes that should hear the sender
         again.
         """
+        if receivers is None:
+            unmute_sender(sender)
+            return
+
         for receiver in self._get_receivers(receivers):
-            self[receiver].discard(sender)
+            unmute(sender, receiver)
 
     def is_muted(self, sender, receivers=None):
         """Return True if a player is muted.
@@ -101,27 +106,16 @@ class _MuteManager(collections.defaultdict):
         pass a tuple that contains the player indexes that should be checked.
         """
         return all(map(
-            lambda receiver: sender in self[receiver],
+            lambda receiver: is_muted(sender, receiver),
             self._get_receivers(receivers)))
 
 # The singleton object of the :class:`_MuteManager` class
-mute_manager = _MuteManager(set)
+mute_manager = _MuteManager()
 
 
 # =============================================================================
 # >> CALLBACKS
 # =============================================================================
-@PreHook(memory.get_virtual_function(voice_server, 'SetClientListening'))
-def _pre_set_client_listening(args):
-    """Called before IVoiceServer::SetClientListening is called."""
-    receiver = args[1]
-    sender = args[2]
-
-    # Check if the sender is muted for this receiver
-    if mute_manager.is_muted(sender, [receiver]):
-        args[3] = False
-
-
 @OnClientDisconnect
 def _on_client_disconnect(index):
     """Called when a player left the server."""
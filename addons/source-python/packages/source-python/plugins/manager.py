@@ -23,6 +23,7 @@ import re
 #   Core
 from core import AutoUnload
 from core import WeakAutoUnload
+from core.profiler import startup_profiler
 #   Hooks
 from hooks.exceptions import except_hooks
 #   Listeners
@@ -204,7 +205,8 @@ class PluginManager(OrderedDict):
 
         try:
             # Actually load the plugin
-            plugin._load()
+            with startup_profiler.section('plugin ' + plugin.import_name):
+                plugin._load()
         except:
             self.pop(plugin_name, 0)
             self._remove_modules(plugin_name)
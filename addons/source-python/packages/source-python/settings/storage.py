@@ -6,14 +6,24 @@
 # >> IMPORTS
 # =============================================================================
 # Python Imports
+#   Queue
+from queue import Empty
+from queue import Queue
 #   SQLite3
 from sqlite3 import connect
+from sqlite3 import Error
 
 # Source.Python Imports
+#   Hooks
+from hooks.exceptions import except_hooks
 #   Listeners
+from listeners import on_client_active_listener_manager
 from listeners import on_level_shutdown_listener_manager
+from listeners.tick import GameThread
 #   Paths
 from paths import SP_DATA_PATH
+#   Players
+from players.helpers import uniqueid_from_index
 
 
 # =============================================================================
@@ -28,6 +38,16 @@ if not _STORAGE_PATH.parent.isdir():
     # Create the ../data/source-python/settings/ directory
     _STORAGE_PATH.parent.mkdir()
 
+# Maximum number of pending writes before the game thread has to wait for
+#   the writer thread to catch up
+_MAX_PENDING_WRITES = 4096
+
+# Maximum number of writes that are stored within a single transaction
+_MAX_BATCH_SIZE = 512
+
+# Object put into the write queue to stop the writer thread
+_STOP_WRITER = object()
+
 
 # =============================================================================
 # >> CLASSES
@@ -36,49 +56,108 @@ class _UniqueSettings(dict):
     """Class used to interact with the database for a specific uniqueid."""
 
     def __init__(self, uniqueid):
-        """Store the given uniqueid and adds it to the players table."""
+        """Store the given uniqueid."""
         # Call the super class' __init__ to initialize the dictionary
         super().__init__()
 
         # Store the given uniqueid
         self.uniqueid = uniqueid
 
-        # If _player_settings_storage is initializing, don't try to call it
-        if _IN_INITIALIZATION:
-            return
-
-        # Add the uniqueid to the players table if it is not already a member
-        _player_settings_storage.cursor.execute(
-            """INSERT OR IGNORE INTO players VALUES(null, ?)""",
-            (self.uniqueid, ))
-
     def __setitem__(self, variable, value):
-        """Insert the given variable and value to their respective tables."""
+        """Set the value and queue it to be written to the database."""
         # Set the given variable's value in the dictionary
         super().__setitem__(variable, value)
 
-        # If _player_settings_storage is initializing, don't try to call it
-        if _IN_INITIALIZATION:
+        # Queue the value to be written by the writer thread
+        _player_settings_storage.queue_write(self.uniqueid, variable, value)
+
+
+class _SettingsWriter(GameThread):
+    """Thread that writes queued settings to the database in batches."""
+
+    def __init__(self, write_queue):
+        """Store the queue to read the pending writes from."""
+        super().__init__(name='sp.settings.storage', daemon=True)
+        self.queue = write_queue
+
+    def run(self):
+        """Write the queued settings until the thread gets stopped."""
+        # Connections can't be shared between threads, so the writer uses
+        #   its own connection
+        connection = connect(_STORAGE_PATH)
+        connection.text_factory = str
+
+        # Allow the game thread to read while a batch is being written
+        connection.execute("""PRAGMA journal_mode=WAL""")
+        connection.execute("""PRAGMA synchronous=NORMAL""")
+
+        running = True
+        while running:
+
+            # Wait for the first write of the next batch
+            items = [self.queue.get()]
+
+            # Get all other writes that are pending already
+            while len(items) < _MAX_BATCH_SIZE:
+                try:
+                    items.append(self.queue.get_nowait())
+                except Empty:
+                    break
+
+            # Only keep the latest value of each uniqueid/variable combination
+            values = dict()
+            for item in items:
+                if item is _STOP_WRITER:
+                    running = False
+                    break
+
+                uniqueid, variable, value = item
+                values[uniqueid, variable] = value
+
+            try:
+                self._write_batch(connection, values)
+            except Error:
+                except_hooks.print_exception()
+
+            # Mark the batch as done, so flush() can return
+            for item in items:
+                self.queue.task_done()
+
+        connection.close()
+
+    @staticmethod
+    def _write_batch(connection, values):
+        """Write the given values within a single transaction."""
+        if not values:
             return
 
-        # Add the variable to the variables table if it is not already a member
-        _player_settings_storage.cursor.execute(
-            """INSERT OR IGNORE INTO variables VALUES(null, ?)""",
-            (variable, ))
+        # The connection commits when the block is left without an error
+        with connection:
+
+            # Add all players that are not a member of the players table yet
+            connection.executemany(
+                """INSERT OR IGNORE INTO players VALUES(null, ?)""",
+                {(uniqueid, ) for uniqueid, variable in values})
 
-        # Set the value of the variable/uniqueid combination
-        _player_settings_storage.cursor.execute(
-            """INSERT OR REPLACE INTO variable_values SELECT """ +
-            """variables.id, players.id, ? FROM variables, players """ +
-            """WHERE variables.name=? AND players.uniqueid=?""",
-            (value, variable, self.uniqueid))
+            # Add all variables that are not a member of the variables table
+            connection.executemany(
+                """INSERT OR IGNORE INTO variables VALUES(null, ?)""",
+                {(variable, ) for uniqueid, variable in values})
+
+            # Set the value of each variable/uniqueid combination
+            connection.executemany(
+                """INSERT OR REPLACE INTO variable_values VALUES(""" +
+                """(SELECT id FROM variables WHERE name=?), """ +
+                """(SELECT id FROM players WHERE uniqueid=?), ?)""",
+                [(variable, uniqueid, value) for (
+                    uniqueid, variable), value in values.items()])
 
 
 class _PlayerSettingsDictionary(dict):
     """Dictionary class used to store user specific settings values."""
 
     def __init__(self):
-        """Connect to the database and retrieve any stored values."""
+        """Connect to the database and start the writer thread."""
         # Call the super class' __init__ to initialize the dictionary
         super().__init__()
 
@@ -91,6 +170,10 @@ class _PlayerSettingsDictionary(dict):
         # Get the cursor instance
         self.cursor = self.connection.cursor()
 
+        # Store the database in WAL mode, so reads from the game thread
+        #   don't have to wait for the writer thread
+        self.cursor.execute("""PRAGMA journal_mode=WAL""")
+
         # Create the variables table if it does not exist
         self.cursor.execute(
             """CREATE TABLE IF NOT EXISTS variables (id INTEGER """
@@ -106,49 +189,78 @@ class _PlayerSettingsDictionary(dict):
             """CREATE TABLE IF NOT EXISTS variable_values (vid """
             """INTEGER, pid INTEGER, value, PRIMARY KEY (vid, pid))""")
 
-        # Get all current data from the variable_values table
-        data = self.cursor.execute(
-            """SELECT V.name, P.uniqueid, value FROM """ +
-            """variable_values AS R JOIN variables AS V ON """ +
-            """R.vid=V.id JOIN players AS P ON R.pid=P.id""")
-
-        # Fetch all objects from the result
-        data = data.fetchall()
-
-        # Is the table empty?
-        if not data:
-
-            # No need to go further
-            return
-
-        # Loop through all values in the data
-        for variable, uniqueid, value in data:
+        # Store the tables before the writer thread uses them
+        self.connection.commit()
 
-            # Store the value for the given uniqueid and variable name
-            self[uniqueid][variable] = value
+        # Start the thread that writes all changed values
+        self._queue = Queue(_MAX_PENDING_WRITES)
+        self._writer = _SettingsWriter(self._queue)
+        self._writer.start()
 
     def __missing__(self, uniqueid):
-        """Add the given uniqueid to the dictionary."""
+        """Load the given uniqueid's values from the database."""
         # Add the uniqueid to the dictionary
         value = self[uniqueid] = _UniqueSettings(uniqueid)
 
+        # Get all stored values of the uniqueid
+        data = self.cursor.execute(
+            """SELECT V.name, R.value FROM players AS P """ +
+            """JOIN variable_values AS R ON R.pid=P.id """ +
+            """JOIN variables AS V ON R.vid=V.id WHERE P.uniqueid=?""",
+            (uniqueid, ))
+
+        # Store the values without queueing them to be written again
+        dict.update(value, data.fetchall())
+
         # Return the _UniqueSettings instance
         return value
 
+    def load(self, uniqueid):
+        """Load the given uniqueid's values if they aren't loaded yet.
+
+        :param str uniqueid:
+            The uniqueid to load the values of.
+        :rtype: _UniqueSettings
+        """
+        return self[uniqueid]
+
+    def queue_write(self, uniqueid, variable, value):
+        """Queue the given value to be written to the database.
+
+        :param str uniqueid:
+            The uniqueid the value belongs to.
+        :param str variable:
+            The name of the variable.
+        :param value:
+            The value to store.
+        """
+        self._queue.put((uniqueid, variable, value))
+
+    def flush(self):
+        """Wait until all queued values have been written."""
+        self._queue.join()
+
+    def unload(self):
+        """Write all queued values and stop the writer thread."""
+        self._queue.put(_STOP_WRITER)
+        self._writer.join()
+        self.connection.close()
+
+    def on_client_active(self, index):
+        """Load the values of the client that became active."""
+        self.load(uniqueid_from_index(index))
+
     def on_level_shutdown(self):
-        """Store the dictionary to the database on map change."""
-        self.connection.commit()
+        """Write all queued values to the database on map change."""
+        self.flush()
 
-# Set a variable to make sure _UniqueSettings doesn't
-#   call _player_settings_storage while it is being initialized.
-_IN_INITIALIZATION = True
 
 # Get the _PlayerSettingsDictionary instance
 _player_settings_storage = _PlayerSettingsDictionary()
 
-# Now that the initialization is done, allow
-#   _UniqueSettings to call _player_settings_storage.
-_IN_INITIALIZATION = False
+# Register a client active listener to load the player's values
+on_client_active_listener_manager.register_listener(
+    _player_settings_storage.on_client_active)
 
 # Register a level shutdown listener to store the database on map change
 on_level_shutdown_listener_manager.register_listener(
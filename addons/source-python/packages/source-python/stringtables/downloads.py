@@ -5,6 +5,10 @@
 # =============================================================================
 # >> IMPORTS
 # =============================================================================
+# Python Imports
+#   OS
+from os import stat
+
 # Source.Python Imports
 #   Core
 from core import AutoUnload
@@ -61,11 +65,10 @@ class Downloadables(AutoUnload, set):
             Return the number of files that have been added.
         :rtype: int
         """
-        index = 0
-        for index, file in enumerate(GAME_PATH.joinpath(directory).walkfiles(), 1):
-            self.add(file.replace(GAME_PATH, '').replace('\\', '/').lstrip('/'))
-
-        return index
+        files = _directory_cache.get_files(directory)
+        items = [item for item in files if item not in self]
+        self.update(_downloadables_list._add_many_to_download_table(items))
+        return len(files)
 
     def remove_directory(self, directory):
         """Remove all files in the given directory from the downloadables.
@@ -85,14 +88,6 @@ class Downloadables(AutoUnload, set):
                 # Remove the item from the set
                 self.remove(item)
 
-    def _set_all_downloads(self):
-        """Add all downloadables for the script on level init."""
-        # Loop through all items in the list
-        for item in self:
-
-            # Add the item to the downloadables stringtable
-            _downloadables_list._add_to_download_table(item)
-
     def _unload_instance(self):
         """Remove the instance from the downloadables list."""
         _downloadables_list.remove(self)
@@ -121,16 +116,86 @@ class _DownloadablesList(list):
         # Add the given file to the downloadables table.
         self.download_table.add_string(item, item)
 
+    def _add_many_to_download_table(self, items):
+        """Add the given files to the downloadables table at once.
+
+        :return:
+            The files that are in the table afterwards. If the table is full,
+            some files might be missing. If the table doesn't exist yet, all
+            files are returned, because they are added on server spawn.
+        :rtype: list
+        """
+        # Is the server still in launching process?
+        if self.download_table is None:
+
+            # If so, no need to go further...
+            return list(items)
+
+        # Add all files while the stringtables are only unlocked once
+        self.download_table.add_strings(items, True)
+        return [item for item in items if item in self.download_table]
+
     def server_spawn(self, game_event):
         """Add all items stored as downloadables to the stringtable."""
         # Refresh the downloadables table instance
         self._refresh_table_instance()
 
-        # Loop through all items in the list
-        for item in self:
+        # Collect the items of all scripts, so the stringtable is only
+        # updated once and shared items are only added once
+        items = set()
+        for downloadables in self:
+            items.update(downloadables)
+
+        self._add_many_to_download_table(items)
+
 
-            # Set all items in the current item as downloadables
-            item._set_all_downloads()
+class _DirectoryCache(dict):
+    """Caches the files of walked directories.
+
+    A cached walk is reused as long as none of the walked directories has
+    been modified. Creating, removing or renaming a file changes the
+    modification time of the directory that contains it.
+    """
+
+    def get_files(self, directory):
+        """Return the downloadable paths of all files in the directory.
+
+        :param str directory:
+            The directory relative to the game directory.
+        :rtype: tuple
+        """
+        path = GAME_PATH.joinpath(directory)
+        try:
+            mtimes, files = self[path]
+        except KeyError:
+            pass
+        else:
+            if self._is_valid(mtimes):
+                return files
+
+        mtimes = {path: stat(path).st_mtime_ns}
+        for sub_directory in path.walkdirs():
+            mtimes[sub_directory] = stat(sub_directory).st_mtime_ns
+
+        files = tuple(
+            file.replace(GAME_PATH, '').replace('\\', '/').lstrip('/')
+            for file in path.walkfiles())
+
+        self[path] = (mtimes, files)
+        return files
+
+    @staticmethod
+    def _is_valid(mtimes):
+        """Return whether none of the given directories has been modified."""
+        try:
+            return all(
+                stat(directory).st_mtime_ns == mtime
+                for directory, mtime in mtimes.items())
+        except OSError:
+            return False
+
+# Get the _DirectoryCache instance
+_directory_cache = _DirectoryCache()
 
 # Get the _DownloadablesList instance
 _downloadables_list = _DownloadablesList()
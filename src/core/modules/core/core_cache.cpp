@@ -96,19 +96,54 @@ object CCachedProperty::_prepare_value(object value)
 	return values;
 }
 
-void CCachedProperty::_invalidate_cache(PyObject *pRef)
+void CCachedProperty::_invalidate_cache(PyObject *pInstance, PyObject *pRef)
 {
-	try
+	m_cache.erase(pInstance);
+}
+
+PyObject *CCachedProperty::_find_cached_value(PyObject *pInstance)
+{
+	// Returns a borrowed reference or NULL if there is no cached value
+	if (m_bUnbound)
 	{
-		m_cache[handle<>(pRef)].del();
+		UnboundCacheMap::iterator it = m_cache.find(pInstance);
+		if (it == m_cache.end())
+			return NULL;
+
+		return it->second.m_value.ptr();
 	}
-	catch (...)
+
+	PyObject **ppDict = _PyObject_GetDictPtr(pInstance);
+	if (!ppDict)
 	{
-		if (!PyErr_ExceptionMatches(PyExc_KeyError))
-			throw_error_already_set();
+		dict cache = _get_instance_dict(object(handle<>(borrowed(pInstance))));
+		return PyDict_GetItemWithError(cache.ptr(), m_name.ptr());
+	}
 
-		PyErr_Clear();
+	if (!*ppDict)
+		return NULL;
+
+	PyObject *pValue = PyDict_GetItemWithError(*ppDict, m_name.ptr());
+	if (!pValue && PyErr_Occurred())
+		throw_error_already_set();
+
+	return pValue;
+}
+
+dict CCachedProperty::_get_instance_dict(object instance)
+{
+	PyObject **ppDict = _PyObject_GetDictPtr(instance.ptr());
+	if (!ppDict)
+		return extract<dict>(instance.attr("__dict__"));
+
+	if (!*ppDict)
+	{
+		*ppDict = PyDict_New();
+		if (!*ppDict)
+			throw_error_already_set();
 	}
+
+	return extract<dict>(object(handle<>(borrowed(*ppDict))));
 }
 
 
@@ -167,21 +202,17 @@ object CCachedProperty::get_cached_value(object instance)
 			"Unable to retrieve the value of an unbound property."
 		);
 
-	object value;
-
-	if (m_bUnbound)
-		value = m_cache[
-			handle<>(
-				PyWeakref_NewRef(instance.ptr(), NULL)
-			)
-		];
-	else
+	PyObject *pValue = _find_cached_value(instance.ptr());
+	if (!pValue)
 	{
-		dict cache = extract<dict>(instance.attr("__dict__"));
-		value = cache[m_name];
+		if (PyErr_Occurred())
+			throw_error_already_set();
+
+		PyErr_SetObject(PyExc_KeyError, m_name.ptr());
+		throw_error_already_set();
 	}
 
-	return value;
+	return object(handle<>(borrowed(pValue)));
 }
 
 void CCachedProperty::set_cached_value(object instance, object value)
@@ -193,40 +224,53 @@ void CCachedProperty::set_cached_value(object instance, object value)
 		);
 
 	if (m_bUnbound)
-		m_cache[handle<>(
+	{
+		object prepared = _prepare_value(value);
+
+		UnboundCacheMap::iterator it = m_cache.find(instance.ptr());
+		if (it != m_cache.end())
+		{
+			it->second.m_value = prepared;
+			return;
+		}
+
+		// Register the weak reference callback only once per instance
+		object ref = object(handle<>(
 			PyWeakref_NewRef(
 				instance.ptr(),
 				make_function(
-					boost::bind(&CCachedProperty::_invalidate_cache, this, _1),
+					boost::bind(&CCachedProperty::_invalidate_cache, this, instance.ptr(), _1),
 					default_call_policies(),
 					boost::mpl::vector2<void, PyObject *>()
 				).ptr()
 			)
-		)] = _prepare_value(value);
+		));
+
+		CachedValue_t &cached = m_cache[instance.ptr()];
+		cached.m_value = prepared;
+		cached.m_ref = ref;
+	}
 	else
 	{
-		dict cache = extract<dict>(instance.attr("__dict__"));
+		dict cache = _get_instance_dict(instance);
 		cache[m_name] = _prepare_value(value);
 	}
 }
 
 void CCachedProperty::delete_cached_value(object instance)
 {
-	try
+	if (m_bUnbound)
 	{
-		if (m_bUnbound)
-			m_cache[
-				handle<>(
-					PyWeakref_NewRef(instance.ptr(), NULL)
-				)
-			].del();
-		else
-		{
-			dict cache = extract<dict>(instance.attr("__dict__"));
-			cache[m_name].del();
-		}
+		m_cache.erase(instance.ptr());
+		return;
 	}
-	catch (...)
+
+	PyObject **ppDict = _PyObject_GetDictPtr(instance.ptr());
+	if (ppDict && !*ppDict)
+		return;
+
+	dict cache = _get_instance_dict(instance);
+	if (PyDict_DelItem(cache.ptr(), m_name.ptr()) != 0)
 	{
 		if (!PyErr_ExceptionMatches(PyExc_KeyError))
 			throw_error_already_set();
@@ -267,34 +311,33 @@ object CCachedProperty::__get__(object self, object instance, object owner=objec
 		return self;
 
 	CCachedProperty &pSelf = extract<CCachedProperty &>(self);
-	object value;
-
-	try
-	{
-		value = pSelf.get_cached_value(instance);
-	}
-	catch (...)
-	{
-		if (!PyErr_ExceptionMatches(PyExc_KeyError))
-			throw_error_already_set();
+	if (!pSelf.m_name)
+		BOOST_RAISE_EXCEPTION(
+			PyExc_AttributeError,
+			"Unable to retrieve the value of an unbound property."
+		);
 
-		PyErr_Clear();
+	// Hits don't allocate or raise any exceptions
+	PyObject *pValue = pSelf._find_cached_value(instance.ptr());
+	if (pValue)
+		return object(handle<>(borrowed(pValue)));
 
-		object getter = pSelf.get_getter();
-		if (getter.is_none())
-			BOOST_RAISE_EXCEPTION(
-				PyExc_AttributeError,
-				"Unable to retrieve the value of a property that have no getter function."
-			);
+	if (PyErr_Occurred())
+		throw_error_already_set();
 
-		value = getter(
-			*(make_tuple(handle<>(borrowed(instance.ptr()))) + pSelf.m_args),
-			**pSelf.m_kwargs
+	object getter = pSelf.get_getter();
+	if (getter.is_none())
+		BOOST_RAISE_EXCEPTION(
+			PyExc_AttributeError,
+			"Unable to retrieve the value of a property that have no getter function."
 		);
 
-		pSelf.set_cached_value(instance, value);
-	}
+	object value = getter(
+		*(make_tuple(handle<>(borrowed(instance.ptr()))) + pSelf.m_args),
+		**pSelf.m_kwargs
+	);
 
+	pSelf.set_cached_value(instance, value);
 	return value;
 }
 
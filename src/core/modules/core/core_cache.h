@@ -33,6 +33,23 @@
 #include "boost/python.hpp"
 using namespace boost::python;
 
+#include "boost/unordered_map.hpp"
+
+
+//-----------------------------------------------------------------------------
+// Cached value of an unbound property.
+//-----------------------------------------------------------------------------
+struct CachedValue_t
+{
+	object m_value;
+
+	// Weak reference to the instance, which removes the value once the
+	// instance is destroyed
+	object m_ref;
+};
+
+typedef boost::unordered_map<PyObject *, CachedValue_t> UnboundCacheMap;
+
 
 //-----------------------------------------------------------------------------
 // CCachedProperty class.
@@ -47,7 +64,9 @@ public:
 
 	static object _callable_check(object function, const char *szName);
 	static object _prepare_value(object value);
-	void _invalidate_cache(PyObject *pRef);
+	void _invalidate_cache(PyObject *pInstance, PyObject *pRef);
+	PyObject *_find_cached_value(PyObject *pInstance);
+	dict _get_instance_dict(object instance);
 
 	object get_getter();
 	object set_getter(object fget);
@@ -89,7 +108,7 @@ private:
 	object m_owner;
 
 	bool m_bUnbound;
-	dict m_cache;
+	UnboundCacheMap m_cache;
 
 public:
 	object m_doc;
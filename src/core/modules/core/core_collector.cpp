@@ -0,0 +1,243 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "core_collector.h"
+#include "utilities/wrap_macros.h"
+#include "tier0/platform.h"
+
+
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CTickCollector g_TickCollector;
+
+
+//-----------------------------------------------------------------------------
+// CTickCollector.
+//-----------------------------------------------------------------------------
+CTickCollector::CTickCollector()
+{
+	m_bEnabled = false;
+	m_bWasEnabled = true;
+	m_flBudget = COLLECTOR_DEFAULT_BUDGET;
+	m_iMaxDeferredTicks = COLLECTOR_DEFAULT_MAX_DEFERRED_TICKS;
+	m_bLevelCollected = false;
+	Reset();
+}
+
+void CTickCollector::SetEnabled(bool bEnabled)
+{
+	if (bEnabled == m_bEnabled)
+		return;
+
+	object gc = import("gc");
+	if (bEnabled)
+	{
+		m_bWasEnabled = extract<bool>(gc.attr("isenabled")());
+		gc.attr("disable")();
+		m_iDeferredStreak = 0;
+		m_bLevelCollected = false;
+	}
+	else if (m_bWasEnabled)
+	{
+		gc.attr("enable")();
+	}
+
+	m_bEnabled = bEnabled;
+}
+
+void CTickCollector::SetBudget(float flBudget)
+{
+	if (flBudget <= 0 || flBudget > 100)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The budget must be greater than 0 and less or equal to 100.")
+
+	m_flBudget = flBudget;
+}
+
+void CTickCollector::SetMaxDeferredTicks(int iTicks)
+{
+	if (iTicks < 1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The maximum number of deferred ticks must be greater than 0.")
+
+	m_iMaxDeferredTicks = iTicks;
+}
+
+void CTickCollector::OnGameFrame(double flFrameStart, float flTickInterval)
+{
+	if (!m_bEnabled)
+		return;
+
+	m_bLevelCollected = false;
+
+	// The part of the budget that has not been used by the tick listeners
+	float flAvailable = (float) (m_flBudget / 100 * flTickInterval * 1000 - (Plat_FloatTime() - flFrameStart) * 1000);
+	m_flLastAvailableTime = flAvailable;
+
+	BEGIN_BOOST_PY()
+		// Plugins can change the thresholds at any time, so they are read on
+		// every frame
+		object gc = import("gc");
+		tuple counts = extract<tuple>(gc.attr("get_count")());
+		tuple thresholds = extract<tuple>(gc.attr("get_threshold")());
+
+		int iCounts[COLLECTOR_GENERATIONS];
+		int iThresholds[COLLECTOR_GENERATIONS];
+		int iPending = -1;
+		for (int i=COLLECTOR_GENERATIONS-1; i >= 0; --i)
+		{
+			iCounts[i] = extract<int>(counts[i]);
+			iThresholds[i] = extract<int>(thresholds[i]);
+			if (iPending == -1 && iCounts[i] > iThresholds[i])
+				iPending = i;
+		}
+
+		// Like Python, don't collect automatically if the first threshold is 0
+		if (!iThresholds[0])
+			iPending = -1;
+
+		if (iPending == -1)
+		{
+			m_iDeferredStreak = 0;
+			return;
+		}
+
+		// Collect the oldest pending generation that fits into the budget. The
+		// duration of a full collection depends on the size of the heap, so
+		// it's left to the level shutdown until it has been measured once.
+		bool bDeferred = false;
+		for (int i=iPending; i >= 0; --i)
+		{
+			if (iCounts[i] <= iThresholds[i])
+				continue;
+
+			GenerationStats_t& stats = m_Stats[i];
+			bool bFullCollection = i == COLLECTOR_GENERATIONS-1;
+			if ((bFullCollection && !stats.m_ullCollections) || stats.m_flExpectedTime > flAvailable)
+			{
+				// Only young generations are collected regardless of the budget
+				bDeferred |= !bFullCollection;
+				continue;
+			}
+
+			Collect(i);
+			m_iDeferredStreak = 0;
+			return;
+		}
+
+		// Only a full collection is pending, which waits for the level shutdown
+		if (!bDeferred)
+			return;
+
+		m_ullDeferredTicks++;
+		if (++m_iDeferredStreak < m_iMaxDeferredTicks)
+			return;
+
+		// Young generations must not grow without bounds. Full collections
+		// that don't fit into the budget wait for the level shutdown.
+		m_iDeferredStreak = 0;
+		for (int i=iPending < COLLECTOR_GENERATIONS-1 ? iPending : COLLECTOR_GENERATIONS-2; i >= 0; --i)
+		{
+			if (iCounts[i] <= iThresholds[i])
+				continue;
+
+			Collect(i, true);
+			return;
+		}
+	END_BOOST_PY_NORET()
+}
+
+void CTickCollector::OnLevelShutdown()
+{
+	// LevelShutdown can be called multiple times per map change
+	if (!m_bEnabled || m_bLevelCollected)
+		return;
+
+	m_bLevelCollected = true;
+	m_uiLevelCollections++;
+
+	BEGIN_BOOST_PY()
+		Collect(COLLECTOR_GENERATIONS-1, true);
+	END_BOOST_PY_NORET()
+}
+
+int CTickCollector::Collect(int iGeneration, bool bForced)
+{
+	if (iGeneration < 0 || iGeneration >= COLLECTOR_GENERATIONS)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid generation %d.", iGeneration)
+
+	double flStart = Plat_FloatTime();
+	int iCollected = extract<int>(import("gc").attr("collect")(iGeneration));
+	double flTime = (Plat_FloatTime() - flStart) * 1000;
+
+	GenerationStats_t& stats = m_Stats[iGeneration];
+	stats.m_ullCollections++;
+	stats.m_ullCollected += iCollected;
+	stats.m_flTotalTime += flTime;
+	if (flTime > stats.m_flMaxTime)
+		stats.m_flMaxTime = flTime;
+
+	if (bForced)
+		stats.m_ullForced++;
+
+	if (stats.m_ullCollections == 1)
+		stats.m_flExpectedTime = flTime;
+	else
+		stats.m_flExpectedTime += (flTime - stats.m_flExpectedTime) * COLLECTOR_EXPECTED_TIME_WEIGHT;
+
+	return iCollected;
+}
+
+void CTickCollector::Reset()
+{
+	memset(m_Stats, 0, sizeof(m_Stats));
+	m_iDeferredStreak = 0;
+	m_ullDeferredTicks = 0;
+	m_uiLevelCollections = 0;
+	m_flLastAvailableTime = 0;
+}
+
+list CTickCollector::GetStats()
+{
+	list result;
+	for (int i=0; i < COLLECTOR_GENERATIONS; ++i)
+	{
+		GenerationStats_t& stats = m_Stats[i];
+		result.append(make_tuple(
+			stats.m_ullCollections,
+			stats.m_ullForced,
+			stats.m_ullCollected,
+			stats.m_flTotalTime,
+			stats.m_flMaxTime,
+			stats.m_flExpectedTime));
+	}
+
+	return result;
+}
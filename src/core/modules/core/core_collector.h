@@ -0,0 +1,136 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _CORE_COLLECTOR_H
+#define _CORE_COLLECTOR_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "boost/python.hpp"
+using namespace boost::python;
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Number of generations of Python's garbage collector
+#define COLLECTOR_GENERATIONS 3
+
+// Percentage of the tick interval that may be spent on collections
+#define COLLECTOR_DEFAULT_BUDGET 10.0f
+
+// Number of ticks young generations may be deferred before they are
+// collected regardless of the budget
+#define COLLECTOR_DEFAULT_MAX_DEFERRED_TICKS 64
+
+// Weight of the latest collection in the expected duration of a generation
+#define COLLECTOR_EXPECTED_TIME_WEIGHT 0.25
+
+
+//-----------------------------------------------------------------------------
+// Accumulated values of a single generation.
+//-----------------------------------------------------------------------------
+struct GenerationStats_t
+{
+	unsigned long long m_ullCollections;
+	unsigned long long m_ullForced;
+	unsigned long long m_ullCollected;
+
+	// Milliseconds
+	double m_flTotalTime;
+	double m_flMaxTime;
+	double m_flExpectedTime;
+};
+
+
+//-----------------------------------------------------------------------------
+// Runs Python's garbage collector between ticks instead of whenever its
+// allocation thresholds are reached.
+//
+// While enabled, automatic collections are disabled. Once per frame the
+// oldest generation whose threshold has been exceeded is collected, if its
+// expected duration fits into the part of the budget that has not been used
+// by the tick listeners. Young generations that had to be deferred for too
+// many ticks are collected anyway. A full collection is done when the level
+// shuts down and, once its duration is known, on ticks that have time left.
+//-----------------------------------------------------------------------------
+class CTickCollector
+{
+public:
+	CTickCollector();
+
+	bool IsEnabled()
+	{ return m_bEnabled; }
+
+	void SetEnabled(bool bEnabled);
+
+	float GetBudget()
+	{ return m_flBudget; }
+
+	void SetBudget(float flBudget);
+
+	int GetMaxDeferredTicks()
+	{ return m_iMaxDeferredTicks; }
+
+	void SetMaxDeferredTicks(int iTicks);
+
+	void OnGameFrame(double flFrameStart, float flTickInterval);
+	void OnLevelShutdown();
+
+	int Collect(int iGeneration, bool bForced=false);
+	void Reset();
+
+	list GetStats();
+
+	unsigned long long GetDeferredTicks()
+	{ return m_ullDeferredTicks; }
+
+	unsigned int GetLevelCollections()
+	{ return m_uiLevelCollections; }
+
+	float GetLastAvailableTime()
+	{ return m_flLastAvailableTime; }
+
+private:
+	bool m_bEnabled;
+	bool m_bWasEnabled;
+	float m_flBudget;
+	int m_iMaxDeferredTicks;
+
+	int m_iDeferredStreak;
+	bool m_bLevelCollected;
+	unsigned long long m_ullDeferredTicks;
+	unsigned int m_uiLevelCollections;
+	float m_flLastAvailableTime;
+	GenerationStats_t m_Stats[COLLECTOR_GENERATIONS];
+};
+
+extern CTickCollector g_TickCollector;
+
+
+#endif // _CORE_COLLECTOR_H
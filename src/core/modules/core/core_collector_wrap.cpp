@@ -0,0 +1,136 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "export_main.h"
+#include "utilities/wrap_macros.h"
+#include "core_collector.h"
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+static void export_tick_collector(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _core._collector module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_core, _collector)
+{
+	export_tick_collector(_collector);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CTickCollector.
+//-----------------------------------------------------------------------------
+void export_tick_collector(scope _collector)
+{
+	class_<CTickCollector, boost::noncopyable> TickCollector("TickCollector", no_init);
+
+	TickCollector.add_property(
+		"enabled",
+		&CTickCollector::IsEnabled,
+		&CTickCollector::SetEnabled,
+		"Return or set whether garbage collections are run between ticks.\n\n"
+		"While enabled, Python's automatic garbage collection is disabled.\n\n"
+		":rtype: bool"
+	);
+
+	TickCollector.add_property(
+		"budget",
+		&CTickCollector::GetBudget,
+		&CTickCollector::SetBudget,
+		"Return or set the percentage of the tick interval that may be spent on collections.\n\n"
+		"Time spent by tick listeners in the same frame is subtracted.\n\n"
+		":rtype: float"
+	);
+
+	TickCollector.add_property(
+		"max_deferred_ticks",
+		&CTickCollector::GetMaxDeferredTicks,
+		&CTickCollector::SetMaxDeferredTicks,
+		"Return or set the number of ticks young generations may be deferred.\n\n"
+		"Afterwards they are collected regardless of the budget.\n\n"
+		":rtype: int"
+	);
+
+	TickCollector.def(
+		"collect",
+		&CTickCollector::Collect,
+		"Collect a generation and record its duration.\n\n"
+		":param int generation: The generation to collect.\n"
+		":param bool forced: Whether the collection should be counted as forced.\n"
+		":return: The number of unreachable objects.\n"
+		":rtype: int",
+		(arg("generation")=COLLECTOR_GENERATIONS-1, arg("forced")=false)
+	);
+
+	TickCollector.def(
+		"reset",
+		&CTickCollector::Reset,
+		"Remove all recorded values."
+	);
+
+	TickCollector.def(
+		"get_stats",
+		&CTickCollector::GetStats,
+		"Return the recorded values of all generations.\n\n"
+		":return:\n"
+		"	A list that contains a tuple for each generation. Each tuple contains\n"
+		"	the number of collections, forced collections and collected objects,\n"
+		"	the total time, the maximum time and the expected time in milliseconds.\n"
+		":rtype: list"
+	);
+
+	TickCollector.add_property(
+		"deferred_ticks",
+		&CTickCollector::GetDeferredTicks,
+		"Return the number of ticks a pending collection didn't fit into the budget.\n\n"
+		":rtype: int"
+	);
+
+	TickCollector.add_property(
+		"level_collections",
+		&CTickCollector::GetLevelCollections,
+		"Return the number of full collections done at level shutdowns.\n\n"
+		":rtype: int"
+	);
+
+	TickCollector.add_property(
+		"last_available_time",
+		&CTickCollector::GetLastAvailableTime,
+		"Return the milliseconds that were available for collections in the last frame.\n\n"
+		":rtype: float"
+	);
+
+	_collector.attr("tick_collector") = object(ptr(&g_TickCollector));
+	_collector.attr("COLLECTOR_GENERATIONS") = COLLECTOR_GENERATIONS;
+}
@@ -0,0 +1,289 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "core_log.h"
+#include "export_main.h"
+
+
+//-----------------------------------------------------------------------------
+// CLogSink class.
+//-----------------------------------------------------------------------------
+CLogSink::CLogSink()
+{
+	for (int i=0; i < LOG_RING_SLOTS; i++)
+		m_Records[i].m_iSequence = i;
+
+	memset(m_pFiles, 0, sizeof(m_pFiles));
+
+	m_iEnqueuePos = 0;
+	m_iDequeuePos = 0;
+	m_bStop = false;
+
+	m_iWritten = 0;
+	m_iDropped = 0;
+}
+
+CLogSink::~CLogSink()
+{
+	Shutdown();
+}
+
+int CLogSink::OpenFile(const char* szPath)
+{
+	int iFile = -1;
+	for (int i=0; i < LOG_MAX_FILES; i++)
+	{
+		if (!m_pFiles[i])
+		{
+			iFile = i;
+			break;
+		}
+	}
+
+	if (iFile == -1)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to open more than %i log files.", LOG_MAX_FILES)
+
+	FILE* pFile = fopen(szPath, "ab");
+	if (!pFile)
+		BOOST_RAISE_EXCEPTION(PyExc_IOError, "Unable to open log file \"%s\".", szPath)
+
+	m_pFiles[iFile] = pFile;
+
+	// The writer thread is only started if it's actually required
+	if (!IsAlive())
+	{
+		m_bStop = false;
+		Start();
+	}
+
+	return iFile;
+}
+
+void CLogSink::CloseFile(int iFile)
+{
+	ValidateFile(iFile);
+
+	// Make sure no pending record refers to the file anymore
+	Flush();
+
+	// Wait until the writer thread doesn't use the file anymore
+	AUTO_LOCK(m_FileMutex);
+	fclose(m_pFiles[iFile]);
+	m_pFiles[iFile] = NULL;
+}
+
+void CLogSink::ValidateFile(int iFile)
+{
+	if (iFile < 0 || iFile >= LOG_MAX_FILES || !m_pFiles[iFile])
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid log file: %i.", iFile)
+}
+
+bool CLogSink::Write(int iFile, const char* szRecord)
+{
+	ValidateFile(iFile);
+
+	int iLength = strlen(szRecord);
+	long iSlots = iLength ? (iLength + LOG_RECORD_SIZE - 1) / LOG_RECORD_SIZE : 1;
+
+	// Records that don't even fit into the empty ring buffer are written
+	// directly after all pending records
+	if (iSlots > LOG_RING_SLOTS)
+	{
+		Flush();
+
+		AUTO_LOCK(m_FileMutex);
+		fwrite(szRecord, 1, iLength, m_pFiles[iFile]);
+		fflush(m_pFiles[iFile]);
+		m_iWritten++;
+		return true;
+	}
+
+	long iPos;
+	if (!Reserve(iSlots, iPos))
+	{
+		// The writer thread didn't catch up yet
+		ThreadInterlockedIncrement(&m_iDropped);
+		m_Wake.Set();
+		return false;
+	}
+
+	for (long i=0; i < iSlots; i++)
+	{
+		LogRecord_t* pRecord = &m_Records[(iPos + i) & (LOG_RING_SLOTS - 1)];
+		int iOffset = i * LOG_RECORD_SIZE;
+		int iChunkLength = iLength - iOffset < LOG_RECORD_SIZE ? iLength - iOffset : LOG_RECORD_SIZE;
+
+		memcpy(pRecord->m_szData, szRecord + iOffset, iChunkLength);
+		pRecord->m_iLength = iChunkLength;
+		pRecord->m_iFile = iFile;
+		pRecord->m_bContinued = i < iSlots - 1;
+
+		// Publish the slot to the writer thread
+		ThreadInterlockedExchange(&pRecord->m_iSequence, iPos + i + 1);
+	}
+
+	return true;
+}
+
+bool CLogSink::Reserve(long iSlots, long& iPos)
+{
+	iPos = m_iEnqueuePos;
+	while (true)
+	{
+		// Are all slots free in this round?
+		long iDiff = 0;
+		for (long i=0; i < iSlots && iDiff == 0; i++)
+			iDiff = m_Records[(iPos + i) & (LOG_RING_SLOTS - 1)].m_iSequence - (iPos + i);
+
+		if (iDiff == 0)
+		{
+			// Reserve the slots
+			if (ThreadInterlockedCompareExchange(&m_iEnqueuePos, iPos + iSlots, iPos) == iPos)
+				return true;
+		}
+		else if (iDiff < 0)
+		{
+			return false;
+		}
+
+		iPos = m_iEnqueuePos;
+	}
+}
+
+bool CLogSink::Drain()
+{
+	bool bFiles[LOG_MAX_FILES] = {false};
+	bool bWritten = false;
+
+	AUTO_LOCK(m_FileMutex);
+
+	while (true)
+	{
+		long iPos = m_iDequeuePos;
+		LogRecord_t* pRecord = &m_Records[iPos & (LOG_RING_SLOTS - 1)];
+
+		// Is the next record still being written or is the buffer empty?
+		if (pRecord->m_iSequence - (iPos + 1) < 0)
+			break;
+
+		FILE* pFile = m_pFiles[pRecord->m_iFile];
+		if (pFile)
+		{
+			// Files are buffered, so this doesn't hit the disk per record
+			fwrite(pRecord->m_szData, 1, pRecord->m_iLength, pFile);
+			bFiles[pRecord->m_iFile] = true;
+		}
+
+		// Split records are counted once
+		if (!pRecord->m_bContinued)
+			m_iWritten++;
+
+		// Give the slot back to the producers
+		ThreadInterlockedExchange(&pRecord->m_iSequence, iPos + LOG_RING_SLOTS);
+		ThreadInterlockedExchange(&m_iDequeuePos, iPos + 1);
+
+		bWritten = true;
+	}
+
+	for (int i=0; i < LOG_MAX_FILES; i++)
+	{
+		if (bFiles[i] && m_pFiles[i])
+			fflush(m_pFiles[i]);
+	}
+
+	return bWritten;
+}
+
+int CLogSink::Run()
+{
+	while (!m_bStop)
+	{
+		m_Wake.Wait(LOG_WRITER_INTERVAL);
+		Drain();
+	}
+
+	// Write everything that has been added before the thread was stopped
+	Drain();
+	return 0;
+}
+
+void CLogSink::Flush()
+{
+	if (!IsAlive())
+	{
+		Drain();
+		return;
+	}
+
+	long iPos = m_iEnqueuePos;
+	while (m_iDequeuePos - iPos < 0)
+	{
+		m_Wake.Set();
+		ThreadSleep(1);
+	}
+}
+
+void CLogSink::Shutdown()
+{
+	if (IsAlive())
+	{
+		m_bStop = true;
+		m_Wake.Set();
+		Join();
+	}
+	else
+	{
+		Drain();
+	}
+
+	for (int i=0; i < LOG_MAX_FILES; i++)
+	{
+		if (m_pFiles[i])
+		{
+			fclose(m_pFiles[i]);
+			m_pFiles[i] = NULL;
+		}
+	}
+}
+
+int CLogSink::GetPending()
+{
+	return m_iEnqueuePos - m_iDequeuePos;
+}
+
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+CLogSink* GetLogSink()
+{
+	static CLogSink* s_pLogSink = new CLogSink();
+	return s_pLogSink;
+}
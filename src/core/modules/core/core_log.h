@@ -0,0 +1,119 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _CORE_LOG_H
+#define _CORE_LOG_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include "tier0/threadtools.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Number of records the ring buffer can hold. Must be a power of two.
+#define LOG_RING_SLOTS 1024
+
+// Number of bytes a slot can hold. Longer records are split across
+// consecutive slots.
+#define LOG_RECORD_SIZE 1024
+
+// Maximum number of files that can be opened at the same time
+#define LOG_MAX_FILES 64
+
+// Milliseconds the writer thread waits for new records before it checks
+// the ring buffer again
+#define LOG_WRITER_INTERVAL 100
+
+
+//-----------------------------------------------------------------------------
+// A slot of the ring buffer.
+//-----------------------------------------------------------------------------
+struct LogRecord_t
+{
+	volatile long m_iSequence;
+	int m_iFile;
+	int m_iLength;
+	bool m_bContinued;
+	char m_szData[LOG_RECORD_SIZE];
+};
+
+
+//-----------------------------------------------------------------------------
+// Writes preformatted log records to files from a background thread.
+//
+// Records are put into a bounded multi producer/single consumer ring buffer
+// without locking. If the ring buffer is full, records are dropped and
+// counted instead of blocking the caller. Files are only accessed while
+// holding the file mutex, so they can't be closed while they are written.
+//-----------------------------------------------------------------------------
+class CLogSink: public CThread
+{
+public:
+	CLogSink();
+	~CLogSink();
+
+	int OpenFile(const char* szPath);
+	void CloseFile(int iFile);
+
+	bool Write(int iFile, const char* szRecord);
+	void Flush();
+	void Shutdown();
+
+	int GetPending();
+	int GetCapacity() { return LOG_RING_SLOTS; }
+	unsigned int GetWritten() { return m_iWritten; }
+	unsigned int GetDropped() { return m_iDropped; }
+
+protected:
+	virtual int Run();
+
+private:
+	void ValidateFile(int iFile);
+	bool Reserve(long iSlots, long& iPos);
+	bool Drain();
+
+private:
+	LogRecord_t m_Records[LOG_RING_SLOTS];
+	volatile long m_iEnqueuePos;
+	volatile long m_iDequeuePos;
+
+	FILE* m_pFiles[LOG_MAX_FILES];
+	CThreadMutex m_FileMutex;
+	CThreadEvent m_Wake;
+	volatile bool m_bStop;
+
+	volatile unsigned int m_iWritten;
+	volatile long m_iDropped;
+};
+
+CLogSink* GetLogSink();
+
+
+#endif // _CORE_LOG_H
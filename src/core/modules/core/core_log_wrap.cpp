@@ -0,0 +1,134 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "export_main.h"
+#include "core_log.h"
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+static void export_log_sink(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _core._log module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_core, _log)
+{
+	export_log_sink(_log);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CLogSink.
+//-----------------------------------------------------------------------------
+void export_log_sink(scope _log)
+{
+	class_<CLogSink, boost::noncopyable> LogSink("LogSink", no_init);
+
+	LogSink.def(
+		"open",
+		&CLogSink::OpenFile,
+		"Open a file to append records to.\n"
+		"\n"
+		":param str path:\n"
+		"	The path of the file.\n"
+		":return:\n"
+		"	The identifier to pass to :meth:`write`.\n"
+		":rtype: int",
+		args("self", "path")
+	);
+
+	LogSink.def(
+		"close",
+		&CLogSink::CloseFile,
+		"Write all pending records and close the given file.\n"
+		"\n"
+		":param int file:\n"
+		"	The identifier returned by :meth:`open`.",
+		args("self", "file")
+	);
+
+	LogSink.def(
+		"write",
+		&CLogSink::Write,
+		"Queue a formatted record to be written by the writer thread.\n"
+		"\n"
+		":param int file:\n"
+		"	The identifier returned by :meth:`open`.\n"
+		":param str record:\n"
+		"	The formatted record including the line break.\n"
+		":return:\n"
+		"	False if the record was dropped, because the ring buffer is full.\n"
+		":rtype: bool",
+		args("self", "file", "record")
+	);
+
+	LogSink.def(
+		"flush",
+		&CLogSink::Flush,
+		"Wait until all queued records have been written."
+	);
+
+	LogSink.add_property(
+		"pending",
+		&CLogSink::GetPending,
+		"Return the number of records that haven't been written yet.\n"
+		"\n"
+		":rtype: int"
+	);
+
+	LogSink.add_property(
+		"capacity",
+		&CLogSink::GetCapacity,
+		"Return the number of records the ring buffer can hold.\n"
+		"\n"
+		":rtype: int"
+	);
+
+	LogSink.add_property(
+		"written",
+		&CLogSink::GetWritten,
+		"Return the number of records that have been written.\n"
+		"\n"
+		":rtype: int"
+	);
+
+	LogSink.add_property(
+		"dropped",
+		&CLogSink::GetDropped,
+		"Return the number of records that have been dropped, because the ring buffer was full.\n"
+		"\n"
+		":rtype: int"
+	);
+
+	// Singleton...
+	_log.attr("log_sink") = object(ptr(GetLogSink()));
+}
@@ -0,0 +1,616 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <cerrno>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <sys/un.h>
+#endif
+
+// Source.Python
+#include "core_metrics.h"
+#include "utilities/wrap_macros.h"
+
+
+//-----------------------------------------------------------------------------
+// Global variables.
+//-----------------------------------------------------------------------------
+CMetricsRegistry g_Metrics;
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+// Prevents the compiler from moving writes across this point. x86 doesn't
+// reorder stores, so that's enough to publish a slot.
+inline void CompilerBarrier()
+{
+#ifdef _WIN32
+	_ReadWriteBarrier();
+#else
+	__asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+static bool IsValidMetricName(const char* szName)
+{
+	if (!szName || !*szName || strlen(szName) >= METRICS_NAME_LENGTH)
+		return false;
+
+	// Same rules as Prometheus: [a-zA-Z_:][a-zA-Z0-9_:]*
+	for (const char* c = szName; *c; ++c)
+	{
+		bool bValid = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || *c == '_' || *c == ':'
+			|| (c != szName && *c >= '0' && *c <= '9');
+
+		if (!bValid)
+			return false;
+	}
+
+	return true;
+}
+
+static double GetBucketBound(int iBucket)
+{
+	return ldexp(1.0, iBucket - METRICS_HISTOGRAM_OFFSET);
+}
+
+static void AppendFormat(std::string& result, const char* szFormat, ...)
+{
+	char szBuffer[256];
+	va_list args;
+	va_start(args, szFormat);
+	vsnprintf(szBuffer, sizeof(szBuffer), szFormat, args);
+	va_end(args);
+	result += szBuffer;
+}
+
+
+//-----------------------------------------------------------------------------
+// Serves the metrics through a Unix socket. Each client receives the
+// metrics in the Prometheus text format, then the connection is closed.
+//-----------------------------------------------------------------------------
+#ifndef _WIN32
+class CMetricsSocketThread: public CThread
+{
+public:
+	CMetricsSocketThread(CMetricsRegistry* pRegistry, int iSocket)
+	{
+		m_pRegistry = pRegistry;
+		m_iSocket = iSocket;
+		m_bStop = false;
+	}
+
+	~CMetricsSocketThread()
+	{
+		close(m_iSocket);
+	}
+
+	void Stop()
+	{
+		m_bStop = true;
+		Join();
+	}
+
+protected:
+	virtual int Run()
+	{
+		while (!m_bStop)
+		{
+			// Wake up regularly to check whether the thread should stop
+			pollfd poll_fd = {m_iSocket, POLLIN, 0};
+			if (poll(&poll_fd, 1, 500) <= 0)
+				continue;
+
+			int iClient = accept(m_iSocket, NULL, NULL);
+			if (iClient < 0)
+				continue;
+
+			std::string text = m_pRegistry->FormatPrometheus();
+			const char* szData = text.c_str();
+			size_t uiLeft = text.size();
+			while (uiLeft > 0)
+			{
+				ssize_t iSent = send(iClient, szData, uiLeft, MSG_NOSIGNAL);
+				if (iSent <= 0)
+					break;
+
+				szData += iSent;
+				uiLeft -= iSent;
+			}
+
+			close(iClient);
+		}
+
+		return 0;
+	}
+
+private:
+	CMetricsRegistry* m_pRegistry;
+	int m_iSocket;
+	volatile bool m_bStop;
+};
+#endif
+
+
+//-----------------------------------------------------------------------------
+// CMetricsRegistry.
+//-----------------------------------------------------------------------------
+CMetricsRegistry::CMetricsRegistry()
+{
+	memset(&m_LocalData, 0, sizeof(m_LocalData));
+
+	MetricsHeader_t& header = m_LocalData.m_Header;
+	header.m_uiMagic = METRICS_MAGIC;
+	header.m_uiVersion = METRICS_VERSION;
+	header.m_uiMaxMetrics = METRICS_MAX_METRICS;
+	header.m_uiHistogramBuckets = METRICS_HISTOGRAM_BUCKETS;
+	header.m_iHistogramOffset = METRICS_HISTOGRAM_OFFSET;
+
+#ifdef _WIN32
+	header.m_uiPid = GetCurrentProcessId();
+	m_hMapping = NULL;
+#else
+	header.m_uiPid = getpid();
+#endif
+
+	m_pData = &m_LocalData;
+	m_pSocketThread = NULL;
+
+	RegisterBuiltins();
+}
+
+CMetricsRegistry::~CMetricsRegistry()
+{
+	CloseSocket();
+	CloseSharedMemory();
+}
+
+void CMetricsRegistry::RegisterBuiltins()
+{
+	Register("sp_tick_callback_calls_total", METRIC_TYPE_COUNTER);
+	Register("sp_hook_callback_calls_total", METRIC_TYPE_COUNTER);
+	Register("sp_listener_callback_calls_total", METRIC_TYPE_COUNTER);
+	Register("sp_event_callback_calls_total", METRIC_TYPE_COUNTER);
+	Register("sp_hook_rule_matches_total", METRIC_TYPE_COUNTER);
+	Register("sp_tick_time_ms", METRIC_TYPE_HISTOGRAM);
+}
+
+int CMetricsRegistry::Register(const char* szName, MetricType_t eType)
+{
+	if (!IsValidMetricName(szName))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid metric name \"%s\".", szName ? szName : "")
+
+	if (eType != METRIC_TYPE_COUNTER && eType != METRIC_TYPE_GAUGE && eType != METRIC_TYPE_HISTOGRAM)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid metric type %d.", (int) eType)
+
+	// Plugins register their metrics again after a reload
+	int iMetric = Find(szName);
+	if (iMetric != METRICS_INVALID)
+	{
+		if (GetType(iMetric) != eType)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Metric \"%s\" has already been registered with another type.", szName)
+
+		return iMetric;
+	}
+
+	AUTO_LOCK(m_Mutex);
+	MetricsHeader_t& header = m_pData->m_Header;
+	if (header.m_uiCount >= METRICS_MAX_METRICS)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Unable to register \"%s\". The maximum number of metrics has been reached.", szName)
+
+	iMetric = (int) header.m_uiCount;
+	MetricSlot_t& slot = m_pData->m_Slots[iMetric];
+	strncpy(slot.m_szName, szName, METRICS_NAME_LENGTH - 1);
+	slot.m_szName[METRICS_NAME_LENGTH - 1] = '\0';
+	slot.m_uiType = eType;
+
+	// Readers must not see the slot before it has been filled
+	CompilerBarrier();
+	header.m_uiCount = iMetric + 1;
+	return iMetric;
+}
+
+int CMetricsRegistry::Find(const char* szName)
+{
+	int iCount = GetCount();
+	for (int i=0; i < iCount; ++i)
+	{
+		if (strcmp(m_pData->m_Slots[i].m_szName, szName) == 0)
+			return i;
+	}
+
+	return METRICS_INVALID;
+}
+
+void CMetricsRegistry::Observe(int iMetric, double flValue)
+{
+	if (!IsValid(iMetric))
+		return;
+
+	// The smallest bucket whose upper bound is >= flValue
+	int iBucket = 0;
+	if (flValue > 0)
+	{
+		int iExponent;
+		double flMantissa = frexp(flValue, &iExponent);
+		iBucket = (flMantissa == 0.5 ? iExponent - 1 : iExponent) + METRICS_HISTOGRAM_OFFSET;
+		if (iBucket < 0)
+			iBucket = 0;
+	}
+
+	MetricSlot_t& slot = m_pData->m_Slots[iMetric];
+	slot.m_uiSequence++;
+	slot.m_ullCount++;
+	slot.m_flValue += flValue;
+	if (iBucket < METRICS_HISTOGRAM_BUCKETS)
+		slot.m_ullBuckets[iBucket]++;
+
+	slot.m_uiSequence++;
+}
+
+bool CMetricsRegistry::Read(int iMetric, MetricSlot_t& result)
+{
+	MetricSlot_t& slot = m_pData->m_Slots[iMetric];
+	for (int iAttempt=0; iAttempt < METRICS_READ_RETRIES; ++iAttempt)
+	{
+		unsigned int uiSequence = slot.m_uiSequence;
+		if (uiSequence & 1)
+		{
+			ThreadPause();
+			continue;
+		}
+
+		memcpy(result.m_szName, slot.m_szName, METRICS_NAME_LENGTH);
+		result.m_uiType = slot.m_uiType;
+		result.m_uiSequence = uiSequence;
+		result.m_ullCount = slot.m_ullCount;
+		result.m_flValue = slot.m_flValue;
+		for (int i=0; i < METRICS_HISTOGRAM_BUCKETS; ++i)
+			result.m_ullBuckets[i] = slot.m_ullBuckets[i];
+
+		if (slot.m_uiSequence == uiSequence)
+			return true;
+	}
+
+	return false;
+}
+
+const char* CMetricsRegistry::GetName(int iMetric)
+{
+	if (!IsValid(iMetric))
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid metric index %d.", iMetric)
+
+	return m_pData->m_Slots[iMetric].m_szName;
+}
+
+MetricType_t CMetricsRegistry::GetType(int iMetric)
+{
+	if (!IsValid(iMetric))
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid metric index %d.", iMetric)
+
+	return (MetricType_t) m_pData->m_Slots[iMetric].m_uiType;
+}
+
+object CMetricsRegistry::GetValue(int iMetric)
+{
+	if (!IsValid(iMetric))
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid metric index %d.", iMetric)
+
+	MetricSlot_t slot;
+	if (!Read(iMetric, slot))
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to read metric %d, because it's constantly being written.", iMetric)
+	switch (slot.m_uiType)
+	{
+		case METRIC_TYPE_COUNTER:
+			return object(slot.m_ullCount);
+		case METRIC_TYPE_GAUGE:
+			return object(slot.m_flValue);
+	}
+
+	list buckets;
+	for (int i=0; i < METRICS_HISTOGRAM_BUCKETS; ++i)
+		buckets.append(make_tuple(GetBucketBound(i), slot.m_ullBuckets[i]));
+
+	return make_tuple(slot.m_ullCount, slot.m_flValue, buckets);
+}
+
+void CMetricsRegistry::Reset(int iMetric)
+{
+	if (!IsValid(iMetric))
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Invalid metric index %d.", iMetric)
+
+	MetricSlot_t& slot = m_pData->m_Slots[iMetric];
+	slot.m_uiSequence++;
+	slot.m_ullCount = 0;
+	slot.m_flValue = 0;
+	for (int i=0; i < METRICS_HISTOGRAM_BUCKETS; ++i)
+		slot.m_ullBuckets[i] = 0;
+
+	slot.m_uiSequence++;
+}
+
+dict CMetricsRegistry::GetValues()
+{
+	dict result;
+	int iCount = GetCount();
+	for (int i=0; i < iCount; ++i)
+		result[GetName(i)] = GetValue(i);
+
+	return result;
+}
+
+std::string CMetricsRegistry::FormatPrometheus()
+{
+	// Called by the socket thread, so the segment must not be closed
+	AUTO_LOCK(m_Mutex);
+
+	std::string result;
+	int iCount = GetCount();
+	for (int i=0; i < iCount; ++i)
+	{
+		// Skip metrics that can't be read instead of blocking the socket
+		MetricSlot_t slot;
+		if (!Read(i, slot))
+			continue;
+
+		switch (slot.m_uiType)
+		{
+			case METRIC_TYPE_COUNTER:
+			{
+				AppendFormat(result, "# TYPE %s counter\n%s %llu\n", slot.m_szName, slot.m_szName, slot.m_ullCount);
+			} break;
+			case METRIC_TYPE_GAUGE:
+			{
+				AppendFormat(result, "# TYPE %s gauge\n%s %.17g\n", slot.m_szName, slot.m_szName, slot.m_flValue);
+			} break;
+			case METRIC_TYPE_HISTOGRAM:
+			{
+				AppendFormat(result, "# TYPE %s histogram\n", slot.m_szName);
+
+				// Prometheus buckets are cumulative
+				unsigned long long ullTotal = 0;
+				for (int j=0; j < METRICS_HISTOGRAM_BUCKETS; ++j)
+				{
+					ullTotal += slot.m_ullBuckets[j];
+					AppendFormat(result, "%s_bucket{le=\"%.17g\"} %llu\n", slot.m_szName, GetBucketBound(j), ullTotal);
+				}
+
+				AppendFormat(result, "%s_bucket{le=\"+Inf\"} %llu\n", slot.m_szName, slot.m_ullCount);
+				AppendFormat(result, "%s_sum %.17g\n", slot.m_szName, slot.m_flValue);
+				AppendFormat(result, "%s_count %llu\n", slot.m_szName, slot.m_ullCount);
+			} break;
+		}
+	}
+
+	return result;
+}
+
+#ifndef _WIN32
+// Removes a segment that has been left behind by a server that crashed.
+// Returns false if the segment is still used or not a metrics segment.
+static bool RemoveStaleSegment(const char* szName)
+{
+	int iFile = shm_open(szName, O_RDONLY, 0);
+	if (iFile < 0)
+		return errno == ENOENT;
+
+	MetricsHeader_t header;
+	bool bStale = read(iFile, &header, sizeof(header)) == sizeof(header)
+		&& header.m_uiMagic == METRICS_MAGIC
+		&& kill((pid_t) header.m_uiPid, 0) != 0 && errno == ESRCH;
+
+	close(iFile);
+	return bStale && shm_unlink(szName) == 0;
+}
+#endif
+
+void CMetricsRegistry::OpenSharedMemory(const char* szName)
+{
+	if (!m_strShmName.empty())
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The shared memory segment \"%s\" is already open.", m_strShmName.c_str())
+
+	// Several servers can run on the same host, so the default name is
+	// unique per process
+	char szDefaultName[64];
+	if (!szName || !*szName)
+	{
+		snprintf(szDefaultName, sizeof(szDefaultName), "%s-%u", METRICS_DEFAULT_SHM_NAME, m_LocalData.m_Header.m_uiPid);
+		szName = szDefaultName;
+	}
+
+	size_t uiSize = sizeof(MetricsData_t);
+	MetricsData_t* pData;
+
+#ifdef _WIN32
+	HANDLE hMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD) uiSize, szName);
+	if (!hMapping)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to create the shared memory segment \"%s\" (%lu).", szName, GetLastError())
+
+	if (GetLastError() == ERROR_ALREADY_EXISTS)
+	{
+		CloseHandle(hMapping);
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The shared memory segment \"%s\" is used by another process.", szName)
+	}
+
+	pData = (MetricsData_t*) MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, uiSize);
+	if (!pData)
+	{
+		CloseHandle(hMapping);
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to map the shared memory segment \"%s\" (%lu).", szName, GetLastError())
+	}
+
+	m_hMapping = hMapping;
+#else
+	// Never share a segment with another server, because both would write
+	// the same slots and the first one to unload would remove it
+	int iFile = shm_open(szName, O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (iFile < 0 && errno == EEXIST && RemoveStaleSegment(szName))
+		iFile = shm_open(szName, O_CREAT | O_EXCL | O_RDWR, 0644);
+
+	if (iFile < 0 && errno == EEXIST)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The shared memory segment \"%s\" is used by another process.", szName)
+
+	if (iFile < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to create the shared memory segment \"%s\": %s", szName, strerror(errno))
+
+	if (ftruncate(iFile, uiSize) != 0)
+	{
+		int iError = errno;
+		close(iFile);
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to resize the shared memory segment \"%s\": %s", szName, strerror(iError))
+	}
+
+	pData = (MetricsData_t*) mmap(NULL, uiSize, PROT_READ | PROT_WRITE, MAP_SHARED, iFile, 0);
+	close(iFile);
+	if (pData == MAP_FAILED)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to map the shared memory segment \"%s\": %s", szName, strerror(errno))
+#endif
+
+	// Continue with the current values
+	AUTO_LOCK(m_Mutex);
+	memcpy(pData, &m_LocalData, uiSize);
+	m_pData = pData;
+	m_strShmName = szName;
+}
+
+void CMetricsRegistry::CloseSharedMemory()
+{
+	if (m_strShmName.empty())
+		return;
+
+	AUTO_LOCK(m_Mutex);
+	MetricsData_t* pData = m_pData;
+	memcpy(&m_LocalData, pData, sizeof(MetricsData_t));
+	m_pData = &m_LocalData;
+
+#ifdef _WIN32
+	UnmapViewOfFile(pData);
+	CloseHandle((HANDLE) m_hMapping);
+	m_hMapping = NULL;
+#else
+	munmap(pData, sizeof(MetricsData_t));
+
+	// Readers notice that the server is gone
+	shm_unlink(m_strShmName.c_str());
+#endif
+
+	m_strShmName.clear();
+}
+
+void CMetricsRegistry::Listen(const char* szPath)
+{
+#ifdef _WIN32
+	BOOST_RAISE_EXCEPTION(PyExc_NotImplementedError, "Unix sockets are not supported on Windows.")
+#else
+	if (m_pSocketThread)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Already listening on \"%s\".", m_strSocketPath.c_str())
+
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (strlen(szPath) >= sizeof(address.sun_path))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The socket path \"%s\" is too long.", szPath)
+
+	strcpy(address.sun_path, szPath);
+
+	int iSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (iSocket < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to create a socket: %s", strerror(errno))
+
+	// Remove the socket of a previous run, but nothing else
+	struct stat info;
+	if (lstat(szPath, &info) == 0)
+	{
+		if (!S_ISSOCK(info.st_mode))
+		{
+			close(iSocket);
+			BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "\"%s\" exists and is not a socket.", szPath)
+		}
+
+		// Still served by another process?
+		int iProbe = socket(AF_UNIX, SOCK_STREAM, 0);
+		bool bUsed = iProbe >= 0 && connect(iProbe, (sockaddr*) &address, sizeof(address)) == 0;
+		if (iProbe >= 0)
+			close(iProbe);
+
+		if (bUsed)
+		{
+			close(iSocket);
+			BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The socket \"%s\" is used by another process.", szPath)
+		}
+
+		unlink(szPath);
+	}
+
+	if (bind(iSocket, (sockaddr*) &address, sizeof(address)) != 0 || listen(iSocket, 4) != 0)
+	{
+		int iError = errno;
+		close(iSocket);
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Unable to listen on \"%s\": %s", szPath, strerror(iError))
+	}
+
+	CMetricsSocketThread* pThread = new CMetricsSocketThread(this, iSocket);
+	pThread->Start();
+
+	m_pSocketThread = pThread;
+	m_strSocketPath = szPath;
+#endif
+}
+
+void CMetricsRegistry::CloseSocket()
+{
+#ifndef _WIN32
+	if (!m_pSocketThread)
+		return;
+
+	CMetricsSocketThread* pThread = (CMetricsSocketThread*) m_pSocketThread;
+	pThread->Stop();
+	delete pThread;
+
+	unlink(m_strSocketPath.c_str());
+	m_pSocketThread = NULL;
+	m_strSocketPath.clear();
+#endif
+}
@@ -0,0 +1,280 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _CORE_METRICS_H
+#define _CORE_METRICS_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <string>
+
+// SDK
+#include "tier0/threadtools.h"
+
+// Boost
+#include "boost/python.hpp"
+using namespace boost::python;
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Identifies the shared memory segment ("SPMT")
+#define METRICS_MAGIC 0x544D5053
+#define METRICS_VERSION 1
+
+// Maximum number of metrics
+#define METRICS_MAX_METRICS 128
+
+// Maximum length of a metric name including the null terminating char
+#define METRICS_NAME_LENGTH 64
+
+// Bucket i of a histogram counts the values that are greater than the upper
+// bound of bucket i-1 and less or equal to 2^(i - METRICS_HISTOGRAM_OFFSET).
+// That's 2^-10 (~0.001) to 2^13 (8192). Bigger values are only counted by
+// m_ullCount (the +Inf bucket).
+#define METRICS_HISTOGRAM_BUCKETS 24
+#define METRICS_HISTOGRAM_OFFSET 10
+
+// Returned if a metric could not be registered
+#define METRICS_INVALID -1
+
+// Number of times a slot is read again, because it was written at the same
+// time, before giving up
+#define METRICS_READ_RETRIES 1000
+
+// Default name of the shared memory segment. The process ID is appended,
+// so several servers on the same host don't share a segment.
+#define METRICS_DEFAULT_SHM_NAME "/source-python-metrics"
+
+
+//-----------------------------------------------------------------------------
+// Metric types.
+//-----------------------------------------------------------------------------
+enum MetricType_t
+{
+	METRIC_TYPE_NONE = 0,
+	METRIC_TYPE_COUNTER,
+	METRIC_TYPE_GAUGE,
+	METRIC_TYPE_HISTOGRAM
+};
+
+
+//-----------------------------------------------------------------------------
+// Metrics Source.Python updates itself. They are registered in this order,
+// so their values are also their indexes.
+//-----------------------------------------------------------------------------
+enum BuiltinMetric_t
+{
+	// Python callbacks per FrameSubsystem_t. Game event callbacks are counted
+	// by events.listener, because they are dispatched in Python.
+	METRIC_TICK_CALLBACK_CALLS = 0,
+	METRIC_HOOK_CALLBACK_CALLS,
+	METRIC_LISTENER_CALLBACK_CALLS,
+	METRIC_EVENT_CALLBACK_CALLS,
+
+	// Hook handler calls that have been answered by a native hook rule
+	METRIC_HOOK_RULE_MATCHES,
+
+	// Duration of the OnTick listeners in milliseconds
+	METRIC_TICK_TIME,
+
+	METRIC_BUILTIN_COUNT
+};
+
+
+//-----------------------------------------------------------------------------
+// Binary layout of the shared memory segment.
+//
+// All values are stored in the native byte order of the server (little
+// endian) without padding between the fields:
+//
+//   MetricsHeader_t                   32 bytes
+//   MetricSlot_t[m_uiMaxMetrics]     280 bytes each
+//
+// Only the game thread writes values. A reader has to read a slot while
+// m_uiSequence is even and must retry if m_uiSequence has changed while it
+// was reading the slot. Slots below m_uiCount are in use. Their name and
+// type don't change anymore.
+//-----------------------------------------------------------------------------
+struct MetricsHeader_t
+{
+	unsigned int m_uiMagic;
+	unsigned int m_uiVersion;
+	unsigned int m_uiMaxMetrics;
+	volatile unsigned int m_uiCount;
+	unsigned int m_uiHistogramBuckets;
+	int m_iHistogramOffset;
+
+	// Process ID of the server
+	unsigned int m_uiPid;
+	unsigned int m_uiReserved;
+};
+
+struct MetricSlot_t
+{
+	char m_szName[METRICS_NAME_LENGTH];
+	unsigned int m_uiType;
+	volatile unsigned int m_uiSequence;
+
+	// Counters: the value. Histograms: the number of values.
+	volatile unsigned long long m_ullCount;
+
+	// Gauges: the value. Histograms: the sum of all values.
+	volatile double m_flValue;
+
+	// Histograms: the number of values per bucket (not cumulative)
+	volatile unsigned long long m_ullBuckets[METRICS_HISTOGRAM_BUCKETS];
+};
+
+// The layout is read by other processes, so it must not depend on the compiler
+static_assert(sizeof(MetricsHeader_t) == 32, "MetricsHeader_t must be 32 bytes.");
+static_assert(sizeof(MetricSlot_t) == 280, "MetricSlot_t must be 280 bytes.");
+
+struct MetricsData_t
+{
+	MetricsHeader_t m_Header;
+	MetricSlot_t m_Slots[METRICS_MAX_METRICS];
+};
+
+
+//-----------------------------------------------------------------------------
+// Stores counters, gauges and histograms.
+//
+// The values are either stored in process memory or in a POSIX shared memory
+// segment, so other processes can read them without involving the server.
+// On Linux, they can also be served in the Prometheus text format through a
+// Unix socket.
+//-----------------------------------------------------------------------------
+class CMetricsRegistry
+{
+public:
+	CMetricsRegistry();
+	~CMetricsRegistry();
+
+	int Register(const char* szName, MetricType_t eType);
+	int Find(const char* szName);
+	int GetCount() { return (int) m_pData->m_Header.m_uiCount; }
+
+	// Hot path functions. Invalid indexes are ignored.
+	void Increment(int iMetric, unsigned long long ullValue=1)
+	{
+		if (!IsValid(iMetric))
+			return;
+
+		MetricSlot_t& slot = m_pData->m_Slots[iMetric];
+		slot.m_uiSequence++;
+		slot.m_ullCount += ullValue;
+		slot.m_uiSequence++;
+	}
+
+	void SetGauge(int iMetric, double flValue)
+	{
+		if (!IsValid(iMetric))
+			return;
+
+		MetricSlot_t& slot = m_pData->m_Slots[iMetric];
+		slot.m_uiSequence++;
+		slot.m_flValue = flValue;
+		slot.m_uiSequence++;
+	}
+
+	void Observe(int iMetric, double flValue);
+
+	bool IsValid(int iMetric)
+	{ return iMetric >= 0 && iMetric < (int) m_pData->m_Header.m_uiCount; }
+
+	// Reads a consistent copy of a slot. Returns false if the slot was
+	// written during every attempt.
+	bool Read(int iMetric, MetricSlot_t& result);
+
+	const char* GetName(int iMetric);
+	MetricType_t GetType(int iMetric);
+	object GetValue(int iMetric);
+	void Reset(int iMetric);
+
+	dict GetValues();
+	std::string FormatPrometheus();
+
+	// Shared memory
+	void OpenSharedMemory(const char* szName);
+	void CloseSharedMemory();
+	const char* GetSharedMemoryName() { return m_strShmName.empty() ? NULL : m_strShmName.c_str(); }
+
+	// Prometheus socket
+	void Listen(const char* szPath);
+	void CloseSocket();
+	const char* GetSocketPath() { return m_strSocketPath.empty() ? NULL : m_strSocketPath.c_str(); }
+
+private:
+	void RegisterBuiltins();
+
+private:
+	MetricsData_t m_LocalData;
+	MetricsData_t* volatile m_pData;
+
+	std::string m_strShmName;
+#ifdef _WIN32
+	void* m_hMapping;
+#endif
+
+	std::string m_strSocketPath;
+	CThread* m_pSocketThread;
+
+	// Protects m_pData from being unmapped while the socket thread reads it
+	CThreadMutex m_Mutex;
+};
+
+extern CMetricsRegistry g_Metrics;
+
+
+//-----------------------------------------------------------------------------
+// Observes the milliseconds spent within its lifetime.
+//-----------------------------------------------------------------------------
+class CMetricsTimeScope
+{
+public:
+	CMetricsTimeScope(int iMetric)
+	{
+		m_iMetric = iMetric;
+		m_flStart = Plat_FloatTime();
+	}
+
+	~CMetricsTimeScope()
+	{
+		g_Metrics.Observe(m_iMetric, (Plat_FloatTime() - m_flStart) * 1000);
+	}
+
+private:
+	int m_iMetric;
+	double m_flStart;
+};
+
+
+#endif // _CORE_METRICS_H
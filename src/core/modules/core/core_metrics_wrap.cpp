@@ -0,0 +1,241 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "export_main.h"
+#include "utilities/wrap_macros.h"
+#include "core_metrics.h"
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+static void export_metric_type(scope);
+static void export_metrics_registry(scope);
+static void export_metrics_constants(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _core._metrics module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_core, _metrics)
+{
+	export_metric_type(_metrics);
+	export_metrics_registry(_metrics);
+	export_metrics_constants(_metrics);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports MetricType_t.
+//-----------------------------------------------------------------------------
+void export_metric_type(scope _metrics)
+{
+	enum_<MetricType_t>("MetricType")
+		.value("COUNTER", METRIC_TYPE_COUNTER)
+		.value("GAUGE", METRIC_TYPE_GAUGE)
+		.value("HISTOGRAM", METRIC_TYPE_HISTOGRAM)
+	;
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CMetricsRegistry.
+//-----------------------------------------------------------------------------
+static str FormatPrometheus(CMetricsRegistry* pRegistry)
+{
+	std::string text = pRegistry->FormatPrometheus();
+	return str(text.c_str(), text.size());
+}
+
+void export_metrics_registry(scope _metrics)
+{
+	class_<CMetricsRegistry, boost::noncopyable> MetricsRegistry("MetricsRegistry", no_init);
+
+	MetricsRegistry.def(
+		"register",
+		&CMetricsRegistry::Register,
+		"Register a metric and return its index.\n\n"
+		"If a metric with the same name and type exists, its index is returned.\n\n"
+		":param str name: Name of the metric. Must be a valid Prometheus metric name.\n"
+		":param MetricType metric_type: Type of the metric.\n"
+		":rtype: int\n"
+		":raise ValueError: If the name is invalid, the name is registered with another type or no slot is left.",
+		args("name", "metric_type")
+	);
+
+	MetricsRegistry.def(
+		"find",
+		&CMetricsRegistry::Find,
+		"Return the index of a metric or -1 if it doesn't exist.\n\n"
+		":rtype: int",
+		args("name")
+	);
+
+	MetricsRegistry.def(
+		"increment",
+		&CMetricsRegistry::Increment,
+		"Increment a counter.",
+		(arg("index"), arg("value")=1)
+	);
+
+	MetricsRegistry.def(
+		"set_gauge",
+		&CMetricsRegistry::SetGauge,
+		"Set the value of a gauge.",
+		args("index", "value")
+	);
+
+	MetricsRegistry.def(
+		"observe",
+		&CMetricsRegistry::Observe,
+		"Add a value to a histogram.",
+		args("index", "value")
+	);
+
+	MetricsRegistry.def(
+		"get_name",
+		&CMetricsRegistry::GetName,
+		"Return the name of a metric.\n\n"
+		":rtype: str",
+		args("index")
+	);
+
+	MetricsRegistry.def(
+		"get_type",
+		&CMetricsRegistry::GetType,
+		"Return the type of a metric.\n\n"
+		":rtype: MetricType",
+		args("index")
+	);
+
+	MetricsRegistry.def(
+		"get_value",
+		&CMetricsRegistry::GetValue,
+		"Return the value of a metric.\n\n"
+		":return:\n"
+		"	An int for counters, a float for gauges and a tuple containing the count,\n"
+		"	the sum and a list of (upper bound, count) tuples for histograms.",
+		args("index")
+	);
+
+	MetricsRegistry.def(
+		"reset",
+		&CMetricsRegistry::Reset,
+		"Set the value of a metric back to zero.",
+		args("index")
+	);
+
+	MetricsRegistry.def(
+		"get_values",
+		&CMetricsRegistry::GetValues,
+		"Return a dict containing the values of all metrics by name.\n\n"
+		":rtype: dict"
+	);
+
+	MetricsRegistry.def(
+		"format_prometheus",
+		&FormatPrometheus,
+		"Return all metrics in the Prometheus text format.\n\n"
+		":rtype: str"
+	);
+
+	MetricsRegistry.def(
+		"__len__",
+		&CMetricsRegistry::GetCount,
+		"Return the number of registered metrics."
+	);
+
+	MetricsRegistry.def(
+		"open_shared_memory",
+		&CMetricsRegistry::OpenSharedMemory,
+		"Move the metrics into a shared memory segment.\n\n"
+		":param str name:\n"
+		"	Name of the segment. Defaults to ``METRICS_DEFAULT_SHM_NAME`` followed by\n"
+		"	a hyphen and the process ID.\n"
+		":raise RuntimeError:\n"
+		"	If the segment could not be created or is used by another process.",
+		(arg("name")=object())
+	);
+
+	MetricsRegistry.def(
+		"close_shared_memory",
+		&CMetricsRegistry::CloseSharedMemory,
+		"Move the metrics back into process memory and remove the shared memory segment."
+	);
+
+	MetricsRegistry.add_property(
+		"shared_memory_name",
+		&CMetricsRegistry::GetSharedMemoryName,
+		"Return the name of the shared memory segment or None.\n\n"
+		":rtype: str"
+	);
+
+	MetricsRegistry.def(
+		"listen",
+		&CMetricsRegistry::Listen,
+		"Serve the metrics in the Prometheus text format through a Unix socket.\n\n"
+		"An existing socket at the path is replaced, unless another process serves it.\n"
+		"Every client receives the metrics, then the connection is closed.\n"
+		"Only supported on Linux.\n\n"
+		":param str path: Path of the socket.\n"
+		":raise RuntimeError: If the socket could not be created.",
+		args("path")
+	);
+
+	MetricsRegistry.def(
+		"close_socket",
+		&CMetricsRegistry::CloseSocket,
+		"Stop serving the metrics through the Unix socket."
+	);
+
+	MetricsRegistry.add_property(
+		"socket_path",
+		&CMetricsRegistry::GetSocketPath,
+		"Return the path of the Unix socket or None.\n\n"
+		":rtype: str"
+	);
+
+	_metrics.attr("metrics") = object(ptr(&g_Metrics));
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports constants.
+//-----------------------------------------------------------------------------
+void export_metrics_constants(scope _metrics)
+{
+	_metrics.attr("METRICS_MAGIC") = METRICS_MAGIC;
+	_metrics.attr("METRICS_VERSION") = METRICS_VERSION;
+	_metrics.attr("METRICS_MAX_METRICS") = METRICS_MAX_METRICS;
+	_metrics.attr("METRICS_NAME_LENGTH") = METRICS_NAME_LENGTH;
+	_metrics.attr("METRICS_HISTOGRAM_BUCKETS") = METRICS_HISTOGRAM_BUCKETS;
+	_metrics.attr("METRICS_HISTOGRAM_OFFSET") = METRICS_HISTOGRAM_OFFSET;
+	_metrics.attr("METRICS_DEFAULT_SHM_NAME") = METRICS_DEFAULT_SHM_NAME;
+}
@@ -0,0 +1,356 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "core_profiler.h"
+#include "utilities/wrap_macros.h"
+#include "tier0/platform.h"
+#include "tier1/strtools.h"
+
+
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+CCallbackProfiler g_CallbackProfiler;
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+// Stores "<module>.<qualified name>" of the callback in the given buffer.
+static void GetCallbackName(PyObject* pCallback, char* szBuffer, int iSize)
+{
+	// The callback might have raised an exception that hasn't been printed yet
+	PyObject *pType, *pValue, *pTraceback;
+	PyErr_Fetch(&pType, &pValue, &pTraceback);
+
+	PyObject* pModule = PyObject_GetAttrString(pCallback, "__module__");
+	if (!pModule)
+		PyErr_Clear();
+
+	PyObject* pName = PyObject_GetAttrString(pCallback, "__qualname__");
+	if (!pName)
+	{
+		PyErr_Clear();
+		pName = PyObject_Repr(pCallback);
+	}
+
+	const char* szModule = (pModule && PyUnicode_Check(pModule)) ? PyUnicode_AsUTF8(pModule) : NULL;
+	const char* szName = (pName && PyUnicode_Check(pName)) ? PyUnicode_AsUTF8(pName) : NULL;
+	PyErr_Clear();
+
+	if (szModule)
+		V_snprintf(szBuffer, iSize, "%s.%s", szModule, szName ? szName : "<unknown>");
+	else
+		V_snprintf(szBuffer, iSize, "%s", szName ? szName : "<unknown>");
+
+	Py_XDECREF(pModule);
+	Py_XDECREF(pName);
+	PyErr_Restore(pType, pValue, pTraceback);
+}
+
+
+//-----------------------------------------------------------------------------
+// CCallbackProfiler class.
+//-----------------------------------------------------------------------------
+CCallbackProfiler::CCallbackProfiler()
+{
+	m_bEnabled = false;
+	memset(m_Profiles, 0, sizeof(m_Profiles));
+	Reset();
+}
+
+void CCallbackProfiler::SetEnabled(bool bEnabled)
+{
+	if (bEnabled && !m_bEnabled)
+	{
+		m_ullStartTicks = ReadTimestamp();
+		m_flStartTime = Plat_FloatTime();
+	}
+
+	m_bEnabled = bEnabled;
+}
+
+void CCallbackProfiler::Reset()
+{
+	// Releasing a callback can run arbitrary code, so the table is cleared
+	// before the references are released
+	PyObject* pCallbacks[PROFILER_MAX_CALLBACKS];
+	for (int i=0; i < PROFILER_MAX_CALLBACKS; i++)
+		pCallbacks[i] = m_Profiles[i].m_pCallback;
+
+	memset(m_Profiles, 0, sizeof(m_Profiles));
+	m_uiOverflows = 0;
+	m_ullStartTicks = ReadTimestamp();
+	m_flStartTime = Plat_FloatTime();
+
+	for (int i=0; i < PROFILER_MAX_CALLBACKS; i++)
+		Py_XDECREF(pCallbacks[i]);
+}
+
+CallbackProfile_t* CCallbackProfiler::FindProfile(PyObject* pCallback)
+{
+	// Objects are at least 8 byte aligned, so the lower bits are useless
+	unsigned int uiIndex = (unsigned int) (((unsigned long) pCallback) >> 4);
+	for (int i=0; i < PROFILER_MAX_CALLBACKS; i++)
+	{
+		CallbackProfile_t* pProfile = &m_Profiles[(uiIndex + i) & (PROFILER_MAX_CALLBACKS - 1)];
+		if (pProfile->m_pCallback == pCallback)
+			return pProfile;
+
+		if (!pProfile->m_pCallback)
+		{
+			Py_INCREF(pCallback);
+			pProfile->m_pCallback = pCallback;
+			GetCallbackName(pCallback, pProfile->m_szName, PROFILER_NAME_LENGTH);
+			return pProfile;
+		}
+	}
+
+	return NULL;
+}
+
+void CCallbackProfiler::Add(PyObject* pCallback, unsigned long long ullTicks)
+{
+	CallbackProfile_t* pProfile = FindProfile(pCallback);
+	if (!pProfile)
+	{
+		m_uiOverflows++;
+		return;
+	}
+
+	pProfile->m_ullCalls++;
+	pProfile->m_ullTicks += ullTicks;
+	if (ullTicks > pProfile->m_ullMaxTicks)
+		pProfile->m_ullMaxTicks = ullTicks;
+}
+
+double CCallbackProfiler::GetTicksPerSecond()
+{
+	double flElapsed = Plat_FloatTime() - m_flStartTime;
+	if (flElapsed <= 0)
+		return 0;
+
+	return (ReadTimestamp() - m_ullStartTicks) / flElapsed;
+}
+
+list CCallbackProfiler::GetProfiles()
+{
+	list result;
+	double flTicksPerSecond = GetTicksPerSecond();
+	if (flTicksPerSecond <= 0)
+		return result;
+
+	for (int i=0; i < PROFILER_MAX_CALLBACKS; i++)
+	{
+		CallbackProfile_t* pProfile = &m_Profiles[i];
+		if (!pProfile->m_ullCalls)
+			continue;
+
+		result.append(make_tuple(
+			str(pProfile->m_szName),
+			pProfile->m_ullCalls,
+			pProfile->m_ullTicks / flTicksPerSecond,
+			pProfile->m_ullMaxTicks / flTicksPerSecond
+		));
+	}
+
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// CHistogram class.
+//-----------------------------------------------------------------------------
+CHistogram::CHistogram()
+{
+	Reset();
+}
+
+void CHistogram::Reset()
+{
+	memset(m_uiCounts, 0, sizeof(m_uiCounts));
+	m_uiCount = 0;
+	m_uiMax = 0;
+	m_ullTotal = 0;
+}
+
+void CHistogram::Record(unsigned int uiValue)
+{
+	// Values below HISTOGRAM_SUB_BUCKETS are stored exactly in the first
+	// bucket. Every other bucket covers a power of two.
+	int iBucket = 0;
+	while ((uiValue >> iBucket) >= HISTOGRAM_SUB_BUCKETS)
+		iBucket++;
+
+	int iSubBucket = iBucket ? (uiValue >> (iBucket - 1)) & (HISTOGRAM_SUB_BUCKETS - 1) : uiValue;
+
+	m_uiCounts[iBucket][iSubBucket]++;
+	m_uiCount++;
+	m_ullTotal += uiValue;
+	if (uiValue > m_uiMax)
+		m_uiMax = uiValue;
+}
+
+// Returns the highest value that is stored in the given bucket.
+static unsigned int GetHighestValue(int iBucket, int iSubBucket)
+{
+	if (iBucket == 0)
+		return iSubBucket;
+
+	unsigned long long ullLowest = (unsigned long long) (HISTOGRAM_SUB_BUCKETS + iSubBucket) << (iBucket - 1);
+	unsigned long long ullHighest = ullLowest + (1ULL << (iBucket - 1)) - 1;
+	return ullHighest > 0xFFFFFFFF ? 0xFFFFFFFF : (unsigned int) ullHighest;
+}
+
+unsigned int CHistogram::GetValueAtPercentile(double flPercentile)
+{
+	if (!m_uiCount)
+		return 0;
+
+	unsigned long long ullRequired = (unsigned long long) (flPercentile / 100.0 * m_uiCount + 0.5);
+	if (ullRequired < 1)
+		ullRequired = 1;
+
+	unsigned long long ullCount = 0;
+	for (int i=0; i < HISTOGRAM_BUCKETS; i++)
+	{
+		for (int j=0; j < HISTOGRAM_SUB_BUCKETS; j++)
+		{
+			ullCount += m_uiCounts[i][j];
+			if (ullCount >= ullRequired)
+			{
+				unsigned int uiValue = GetHighestValue(i, j);
+				return uiValue < m_uiMax ? uiValue : m_uiMax;
+			}
+		}
+	}
+
+	return m_uiMax;
+}
+
+list CHistogram::GetBuckets()
+{
+	list result;
+	for (int i=0; i < HISTOGRAM_BUCKETS; i++)
+	{
+		for (int j=0; j < HISTOGRAM_SUB_BUCKETS; j++)
+		{
+			if (m_uiCounts[i][j])
+				result.append(make_tuple(GetHighestValue(i, j), m_uiCounts[i][j]));
+		}
+	}
+
+	return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// CFrameBudget class.
+//-----------------------------------------------------------------------------
+CFrameBudget g_FrameBudget;
+
+static const char* s_szSubsystems[FRAME_SUBSYSTEM_COUNT] = {
+	"tick",
+	"hooks",
+	"listeners",
+	"events"
+};
+
+CFrameBudget::CFrameBudget()
+{
+	m_bEnabled = false;
+	m_flThreshold = 0;
+	m_iDepth = 0;
+	Reset();
+}
+
+void CFrameBudget::SetEnabled(bool bEnabled)
+{
+	if (bEnabled && !m_bEnabled)
+	{
+		// Don't account time of the frame that is already running
+		memset(m_ullFrameTicks, 0, sizeof(m_ullFrameTicks));
+		m_ullStartTicks = CCallbackProfiler::ReadTimestamp();
+		m_flStartTime = Plat_FloatTime();
+	}
+
+	m_bEnabled = bEnabled;
+}
+
+void CFrameBudget::Reset()
+{
+	memset(m_ullFrameTicks, 0, sizeof(m_ullFrameTicks));
+	memset(m_flLastFrame, 0, sizeof(m_flLastFrame));
+	m_flLastFrameTime = 0;
+	m_uiExceeded = 0;
+	m_ullStartTicks = CCallbackProfiler::ReadTimestamp();
+	m_flStartTime = Plat_FloatTime();
+	m_Histogram.Reset();
+}
+
+bool CFrameBudget::EndFrame()
+{
+	if (!m_bEnabled)
+		return false;
+
+	double flElapsed = Plat_FloatTime() - m_flStartTime;
+	unsigned long long ullElapsedTicks = CCallbackProfiler::ReadTimestamp() - m_ullStartTicks;
+	if (flElapsed <= 0 || !ullElapsedTicks)
+		return false;
+
+	// Convert the ticks to milliseconds and start the next frame
+	double flMillisecondsPerTick = flElapsed * 1000.0 / ullElapsedTicks;
+	m_flLastFrameTime = 0;
+	for (int i=0; i < FRAME_SUBSYSTEM_COUNT; i++)
+	{
+		m_flLastFrame[i] = (float) (m_ullFrameTicks[i] * flMillisecondsPerTick);
+		m_flLastFrameTime += m_flLastFrame[i];
+		m_ullFrameTicks[i] = 0;
+	}
+
+	// The histogram stores microseconds
+	m_Histogram.Record((unsigned int) (m_flLastFrameTime * 1000));
+
+	if (m_flThreshold <= 0 || m_flLastFrameTime <= m_flThreshold)
+		return false;
+
+	m_uiExceeded++;
+	return true;
+}
+
+dict CFrameBudget::GetLastFrameBreakdown()
+{
+	dict result;
+	for (int i=0; i < FRAME_SUBSYSTEM_COUNT; i++)
+		result[s_szSubsystems[i]] = m_flLastFrame[i];
+
+	return result;
+}
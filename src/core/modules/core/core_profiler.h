@@ -0,0 +1,302 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _CORE_PROFILER_H
+#define _CORE_PROFILER_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#ifdef _WIN32
+	#include <intrin.h>
+#else
+	#include <x86intrin.h>
+#endif
+
+#include "boost/python.hpp"
+using namespace boost::python;
+
+#include "core_metrics.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Number of callbacks that can be profiled. Must be a power of two.
+#define PROFILER_MAX_CALLBACKS 1024
+
+// Maximum length of a callback's name including the null terminating char
+#define PROFILER_NAME_LENGTH 128
+
+// Each power of two of the histogram is split into this number of linear
+// sub-buckets. Values are recorded with a precision of 1/16 (~6%).
+#define HISTOGRAM_SUB_BUCKET_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+
+// Number of powers of two that are required to store 32 bit values
+#define HISTOGRAM_BUCKETS (32 - HISTOGRAM_SUB_BUCKET_BITS + 1)
+
+
+//-----------------------------------------------------------------------------
+// Subsystems Source.Python's share of a frame is split into.
+//-----------------------------------------------------------------------------
+enum FrameSubsystem_t
+{
+	FRAME_SUBSYSTEM_TICK,
+	FRAME_SUBSYSTEM_HOOKS,
+	FRAME_SUBSYSTEM_LISTENERS,
+	FRAME_SUBSYSTEM_EVENTS,
+
+	FRAME_SUBSYSTEM_COUNT
+};
+
+
+//-----------------------------------------------------------------------------
+// Accumulated values of a single callback.
+//-----------------------------------------------------------------------------
+struct CallbackProfile_t
+{
+	// Strong reference, so the address can't be reused by another callback
+	PyObject* m_pCallback;
+	unsigned long long m_ullCalls;
+	unsigned long long m_ullTicks;
+	unsigned long long m_ullMaxTicks;
+	char m_szName[PROFILER_NAME_LENGTH];
+};
+
+
+//-----------------------------------------------------------------------------
+// Measures the time spent in hook and listener callbacks.
+//
+// The values are stored in a preallocated open addressing table that uses
+// the address of the callback as the key. The name of a callback is only
+// resolved when it's called for the first time. Profiled callbacks are kept
+// alive until the profiler is reset.
+//-----------------------------------------------------------------------------
+class CCallbackProfiler
+{
+public:
+	CCallbackProfiler();
+
+	bool IsEnabled()
+	{ return m_bEnabled; }
+
+	void SetEnabled(bool bEnabled);
+	void Reset();
+	void Add(PyObject* pCallback, unsigned long long ullTicks);
+
+	list GetProfiles();
+	double GetTicksPerSecond();
+
+	unsigned int GetOverflows()
+	{ return m_uiOverflows; }
+
+	static unsigned long long ReadTimestamp()
+	{ return __rdtsc(); }
+
+private:
+	CallbackProfile_t* FindProfile(PyObject* pCallback);
+
+private:
+	bool m_bEnabled;
+	unsigned int m_uiOverflows;
+	unsigned long long m_ullStartTicks;
+	double m_flStartTime;
+	CallbackProfile_t m_Profiles[PROFILER_MAX_CALLBACKS];
+};
+
+extern CCallbackProfiler g_CallbackProfiler;
+
+
+//-----------------------------------------------------------------------------
+// Histogram with a logarithmic bucket layout like HdrHistogram.
+//
+// Small values are stored exactly, bigger values with a constant relative
+// precision, so the histogram has a fixed size for the whole value range.
+//-----------------------------------------------------------------------------
+class CHistogram
+{
+public:
+	CHistogram();
+
+	void Record(unsigned int uiValue);
+	void Reset();
+
+	unsigned int GetCount()
+	{ return m_uiCount; }
+
+	unsigned int GetMax()
+	{ return m_uiMax; }
+
+	double GetMean()
+	{ return m_uiCount ? (double) m_ullTotal / m_uiCount : 0; }
+
+	unsigned int GetValueAtPercentile(double flPercentile);
+	list GetBuckets();
+
+private:
+	unsigned int m_uiCounts[HISTOGRAM_BUCKETS][HISTOGRAM_SUB_BUCKETS];
+	unsigned int m_uiCount;
+	unsigned int m_uiMax;
+	unsigned long long m_ullTotal;
+};
+
+
+//-----------------------------------------------------------------------------
+// Measures Source.Python's share of each server frame.
+//
+// Only the outermost scope of a frame adds its time, so e.g. a hook that is
+// called by a tick listener is accounted to the tick listeners.
+//-----------------------------------------------------------------------------
+class CFrameBudget
+{
+public:
+	CFrameBudget();
+
+	bool IsEnabled()
+	{ return m_bEnabled; }
+
+	void SetEnabled(bool bEnabled);
+
+	float GetThreshold()
+	{ return m_flThreshold; }
+
+	void SetThreshold(float flThreshold)
+	{ m_flThreshold = flThreshold; }
+
+	bool EndFrame();
+	void Reset();
+
+	void Enter()
+	{ m_iDepth++; }
+
+	void Leave(FrameSubsystem_t eSubsystem, unsigned long long ullTicks)
+	{
+		if (--m_iDepth == 0)
+			m_ullFrameTicks[eSubsystem] += ullTicks;
+	}
+
+	float GetLastFrameTime()
+	{ return m_flLastFrameTime; }
+
+	dict GetLastFrameBreakdown();
+
+	unsigned int GetExceeded()
+	{ return m_uiExceeded; }
+
+	CHistogram& GetHistogram()
+	{ return m_Histogram; }
+
+private:
+	bool m_bEnabled;
+	float m_flThreshold;
+	int m_iDepth;
+	unsigned int m_uiExceeded;
+	unsigned long long m_ullStartTicks;
+	double m_flStartTime;
+	unsigned long long m_ullFrameTicks[FRAME_SUBSYSTEM_COUNT];
+	float m_flLastFrame[FRAME_SUBSYSTEM_COUNT];
+	float m_flLastFrameTime;
+	CHistogram m_Histogram;
+};
+
+extern CFrameBudget g_FrameBudget;
+
+
+//-----------------------------------------------------------------------------
+// Adds the time spent within its lifetime to the current frame.
+//-----------------------------------------------------------------------------
+class CFrameBudgetScope
+{
+public:
+	CFrameBudgetScope(FrameSubsystem_t eSubsystem)
+	{
+		m_bActive = g_FrameBudget.IsEnabled();
+		if (!m_bActive)
+			return;
+
+		m_eSubsystem = eSubsystem;
+		g_FrameBudget.Enter();
+		m_ullStart = CCallbackProfiler::ReadTimestamp();
+	}
+
+	~CFrameBudgetScope()
+	{
+		if (m_bActive)
+			g_FrameBudget.Leave(m_eSubsystem, CCallbackProfiler::ReadTimestamp() - m_ullStart);
+	}
+
+private:
+	bool m_bActive;
+	FrameSubsystem_t m_eSubsystem;
+	unsigned long long m_ullStart;
+};
+
+
+//-----------------------------------------------------------------------------
+// Adds the time spent within its lifetime to the given callback and to the
+// current frame.
+//
+// If the profilers are disabled, this only costs two checks.
+//-----------------------------------------------------------------------------
+class CCallbackProfileScope
+{
+public:
+	CCallbackProfileScope(PyObject* pCallback, FrameSubsystem_t eSubsystem):
+		m_FrameScope(eSubsystem)
+	{
+		g_Metrics.Increment(METRIC_TICK_CALLBACK_CALLS + eSubsystem);
+
+		if (!g_CallbackProfiler.IsEnabled())
+		{
+			m_pCallback = NULL;
+			return;
+		}
+
+		// The callback might unregister itself
+		m_pCallback = pCallback;
+		Py_INCREF(m_pCallback);
+		m_ullStart = CCallbackProfiler::ReadTimestamp();
+	}
+
+	~CCallbackProfileScope()
+	{
+		if (!m_pCallback)
+			return;
+
+		g_CallbackProfiler.Add(m_pCallback, CCallbackProfiler::ReadTimestamp() - m_ullStart);
+		Py_DECREF(m_pCallback);
+	}
+
+private:
+	CFrameBudgetScope m_FrameScope;
+	PyObject* m_pCallback;
+	unsigned long long m_ullStart;
+};
+
+
+#endif // _CORE_PROFILER_H
@@ -0,0 +1,211 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "export_main.h"
+#include "utilities/wrap_macros.h"
+#include "core_profiler.h"
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+static void export_callback_profiler(scope);
+static void export_histogram(scope);
+static void export_frame_budget(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _core._profiler module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_core, _profiler)
+{
+	export_callback_profiler(_profiler);
+	export_histogram(_profiler);
+	export_frame_budget(_profiler);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CCallbackProfiler.
+//-----------------------------------------------------------------------------
+void export_callback_profiler(scope _profiler)
+{
+	class_<CCallbackProfiler, boost::noncopyable> CallbackProfiler("CallbackProfiler", no_init);
+
+	CallbackProfiler.add_property(
+		"enabled",
+		&CCallbackProfiler::IsEnabled,
+		&CCallbackProfiler::SetEnabled,
+		"Return or set whether hook and listener callbacks are profiled.\n\n"
+		":rtype: bool"
+	);
+
+	CallbackProfiler.def(
+		"reset",
+		&CCallbackProfiler::Reset,
+		"Remove all recorded values and release the profiled callbacks."
+	);
+
+	CallbackProfiler.def(
+		"get_profiles",
+		&CCallbackProfiler::GetProfiles,
+		"Return the recorded values of all callbacks.\n\n"
+		":return:\n"
+		"	A list of tuples containing the name of the callback, the number of calls,\n"
+		"	the total seconds and the maximum seconds of a single call.\n"
+		":rtype: list"
+	);
+
+	CallbackProfiler.add_property(
+		"overflows",
+		&CCallbackProfiler::GetOverflows,
+		"Return the number of calls that could not be recorded, because the table was full.\n\n"
+		":rtype: int"
+	);
+
+	_profiler.attr("callback_profiler") = object(ptr(&g_CallbackProfiler));
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CHistogram.
+//-----------------------------------------------------------------------------
+void export_histogram(scope _profiler)
+{
+	class_<CHistogram, boost::noncopyable> Histogram("Histogram", no_init);
+
+	Histogram.add_property(
+		"count",
+		&CHistogram::GetCount,
+		"Return the number of recorded values.\n\n"
+		":rtype: int"
+	);
+
+	Histogram.add_property(
+		"max",
+		&CHistogram::GetMax,
+		"Return the highest recorded value.\n\n"
+		":rtype: int"
+	);
+
+	Histogram.add_property(
+		"mean",
+		&CHistogram::GetMean,
+		"Return the mean of all recorded values.\n\n"
+		":rtype: float"
+	);
+
+	Histogram.def(
+		"get_value_at_percentile",
+		&CHistogram::GetValueAtPercentile,
+		"Return the value the given percentage of all recorded values is lower than or equal to.\n\n"
+		":param float percentile:\n"
+		"	The percentile. E.g. 99.9\n"
+		":rtype: int",
+		args("self", "percentile")
+	);
+
+	Histogram.def(
+		"get_buckets",
+		&CHistogram::GetBuckets,
+		"Return all buckets that contain values.\n\n"
+		":return:\n"
+		"	A list of tuples containing the highest value of the bucket and the number of values.\n"
+		":rtype: list"
+	);
+
+	Histogram.def(
+		"reset",
+		&CHistogram::Reset,
+		"Remove all recorded values."
+	);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CFrameBudget.
+//-----------------------------------------------------------------------------
+void export_frame_budget(scope _profiler)
+{
+	class_<CFrameBudget, boost::noncopyable> FrameBudget("FrameBudget", no_init);
+
+	FrameBudget.add_property(
+		"enabled",
+		&CFrameBudget::IsEnabled,
+		&CFrameBudget::SetEnabled,
+		"Return or set whether Source.Python's share of each frame is measured.\n\n"
+		":rtype: bool"
+	);
+
+	FrameBudget.add_property(
+		"threshold",
+		&CFrameBudget::GetThreshold,
+		&CFrameBudget::SetThreshold,
+		"Return or set the milliseconds per frame after which OnTickBudgetExceeded is called.\n"
+		"A value of 0 disables the listener.\n\n"
+		":rtype: float"
+	);
+
+	FrameBudget.add_property(
+		"last_frame_time",
+		&CFrameBudget::GetLastFrameTime,
+		"Return the milliseconds Source.Python has spent in the last frame.\n\n"
+		":rtype: float"
+	);
+
+	FrameBudget.add_property(
+		"exceeded",
+		&CFrameBudget::GetExceeded,
+		"Return the number of frames that exceeded the threshold.\n\n"
+		":rtype: int"
+	);
+
+	FrameBudget.add_property(
+		"histogram",
+		make_function(&CFrameBudget::GetHistogram, reference_existing_object_policy()),
+		"Return the histogram of the frame times in microseconds.\n\n"
+		":rtype: Histogram"
+	);
+
+	FrameBudget.def(
+		"get_last_frame_breakdown",
+		&CFrameBudget::GetLastFrameBreakdown,
+		"Return the milliseconds spent in the last frame per subsystem.\n\n"
+		":rtype: dict"
+	);
+
+	FrameBudget.def(
+		"reset",
+		&CFrameBudget::Reset,
+		"Remove all recorded values."
+	);
+
+	_profiler.attr("frame_budget") = object(ptr(&g_FrameBudget));
+}
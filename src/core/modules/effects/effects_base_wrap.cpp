@@ -44,6 +44,7 @@
 #include "game/shared/effect_dispatch_data.h"
 #include "game/server/basetempentity.h"
 #include "effects_base.h"
+#include "effects_layout.h"
 
 #include ENGINE_INCLUDE_PATH(effects_base_wrap.h)
 
@@ -52,6 +53,7 @@
 // Forward declarations.
 //-----------------------------------------------------------------------------
 void export_base_temp_entity(scope);
+void export_temp_entity_layout(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -60,6 +62,7 @@ void export_base_temp_entity(scope);
 DECLARE_SP_SUBMODULE(_effects, _base)
 {
 	export_base_temp_entity(_base);
+	export_temp_entity_layout(_base);
 }
 
 
@@ -97,3 +100,76 @@ void export_base_temp_entity(scope _base)
 		FUNCTION_INFO(Test)
 	END_CLASS_INFO()
 }
+
+
+//-----------------------------------------------------------------------------
+// Exports CTempEntityLayout.
+//-----------------------------------------------------------------------------
+void export_temp_entity_layout(scope _base)
+{
+	class_<CTempEntityLayout, boost::noncopyable> TempEntityLayout("TempEntityLayout");
+
+	// Compiling...
+	TempEntityLayout.def(
+		"add_field",
+		&CTempEntityLayout::AddField,
+		("name", "offset", "type_name"),
+		"Add an alias that is stored at the given offset.\n\n"
+		":param str type_name: Either ``int``, ``float`` or ``Vector``."
+	);
+
+	TempEntityLayout.def(
+		"add_index_alias",
+		&CTempEntityLayout::AddIndexAlias,
+		("name", "target", arg("cls")=object()),
+		"Add an alias whose values are stored as their index in another field.\n\n"
+		":param str target: The name of the integer field to store the index in.\n"
+		":param cls: If not None, values are required to be an instance of this class."
+	);
+
+	TempEntityLayout.def(
+		"add_color_alias",
+		&CTempEntityLayout::AddColorAlias,
+		("name", "targets"),
+		"Add an alias whose Color values are stored in four fields.\n\n"
+		":param tuple targets: The names of the integer fields to store red, green, blue and alpha in."
+	);
+
+	// Special methods...
+	TempEntityLayout.def("__contains__", &CTempEntityLayout::Contains);
+	TempEntityLayout.def("__len__", &CTempEntityLayout::GetCount);
+
+	// Methods...
+	TempEntityLayout.def(
+		"get",
+		&CTempEntityLayout::Get,
+		("temp_entity", "name"),
+		"Return the value of an alias.\n\n"
+		":raise KeyError: Raised if the alias can't be read natively."
+	);
+
+	TempEntityLayout.def(
+		"set",
+		&CTempEntityLayout::Set,
+		("temp_entity", "name", "value"),
+		"Set the value of an alias.\n\n"
+		":return: False if the alias has not been compiled.\n"
+		":rtype: bool"
+	);
+
+	TempEntityLayout.def(
+		"fill",
+		&CTempEntityLayout::Fill,
+		("temp_entity", "aliases"),
+		"Set the values of all aliases in the given mapping."
+	);
+
+	TempEntityLayout.def(
+		"create_many",
+		&CTempEntityLayout::CreateMany,
+		("temp_entity", "recipient_filter", "rows", arg("delay")=0.0),
+		"Fill and create the temp entity once for each mapping of aliases in the given iterable.\n\n"
+		":return: The number of created effects.\n"
+		":rtype: int"
+	);
+}
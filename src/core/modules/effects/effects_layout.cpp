@@ -0,0 +1,258 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "effects_layout.h"
+#include "mathlib/vector.h"
+#include "Color.h"
+
+
+//-----------------------------------------------------------------------------
+// CTempEntityLayout - compiling
+//-----------------------------------------------------------------------------
+void CTempEntityLayout::AddField(const char* szName, int iOffset, const char* szType)
+{
+	TempEntityField_t field;
+	if (strcmp(szType, "int") == 0)
+		field.m_eType = TE_FIELD_INT;
+	else if (strcmp(szType, "float") == 0)
+		field.m_eType = TE_FIELD_FLOAT;
+	else if (strcmp(szType, "Vector") == 0)
+		field.m_eType = TE_FIELD_VECTOR;
+	else
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unsupported field type \"%s\".", szType)
+
+	field.m_iOffset = iOffset;
+	AddEntry(szName, field);
+}
+
+void CTempEntityLayout::AddIndexAlias(const char* szName, const char* szTarget, object cls)
+{
+	int iTarget = FindField(szTarget);
+	if (iTarget == -1 || m_Fields[iTarget].m_eType != TE_FIELD_INT)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "\"%s\" is not a compiled integer field.", szTarget)
+
+	TempEntityField_t field;
+	field.m_eType = TE_FIELD_INDEX;
+	field.m_iOffset = m_Fields[iTarget].m_iOffset;
+	field.m_iTargets[0] = iTarget;
+	field.m_oClass = cls;
+	AddEntry(szName, field);
+}
+
+void CTempEntityLayout::AddColorAlias(const char* szName, tuple targets)
+{
+	if (len(targets) != 4)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Color aliases require exactly 4 fields.")
+
+	TempEntityField_t field;
+	field.m_eType = TE_FIELD_COLOR;
+	field.m_iOffset = -1;
+	for (int i=0; i < 4; i++)
+	{
+		const char* szTarget = extract<const char*>(targets[i]);
+		int iTarget = FindField(szTarget);
+		if (iTarget == -1 || m_Fields[iTarget].m_eType != TE_FIELD_INT)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "\"%s\" is not a compiled integer field.", szTarget)
+
+		field.m_iTargets[i] = iTarget;
+	}
+
+	AddEntry(szName, field);
+}
+
+int CTempEntityLayout::AddEntry(const char* szName, const TempEntityField_t& field)
+{
+	int iIndex = FindField(szName);
+	if (iIndex != -1)
+	{
+		m_Fields[iIndex] = field;
+		return iIndex;
+	}
+
+	m_Fields.push_back(field);
+	iIndex = m_Fields.size() - 1;
+	m_FieldIndexes.insert(std::make_pair(std::string(szName), iIndex));
+	return iIndex;
+}
+
+
+//-----------------------------------------------------------------------------
+// CTempEntityLayout - lookups
+//-----------------------------------------------------------------------------
+int CTempEntityLayout::FindField(const char* szName)
+{
+	TempEntityFieldMap::iterator it = m_FieldIndexes.find(szName);
+	if (it == m_FieldIndexes.end())
+		return -1;
+
+	return it->second;
+}
+
+bool CTempEntityLayout::Contains(const char* szName)
+{
+	return FindField(szName) != -1;
+}
+
+int CTempEntityLayout::GetCount()
+{
+	return m_Fields.size();
+}
+
+
+//-----------------------------------------------------------------------------
+// CTempEntityLayout - reading and writing
+//-----------------------------------------------------------------------------
+object CTempEntityLayout::Get(CBaseTempEntity* pTempEntity, const char* szName)
+{
+	int iIndex = FindField(szName);
+
+	// The objects of index aliases are created by TempEntity
+	if (iIndex == -1 || m_Fields[iIndex].m_eType == TE_FIELD_INDEX)
+		BOOST_RAISE_EXCEPTION(PyExc_KeyError, "\"%s\" can't be read natively.", szName)
+
+	unsigned char* pBase = (unsigned char*) pTempEntity;
+	const TempEntityField_t& field = m_Fields[iIndex];
+	switch (field.m_eType)
+	{
+		case TE_FIELD_INT:
+			return object(*(int*) (pBase + field.m_iOffset));
+		case TE_FIELD_FLOAT:
+			return object(*(float*) (pBase + field.m_iOffset));
+		case TE_FIELD_VECTOR:
+			// Changes to the vector are applied to the temp entity
+			return object(ptr((Vector*) (pBase + field.m_iOffset)));
+		case TE_FIELD_COLOR:
+			return object(Color(
+				*(int*) (pBase + m_Fields[field.m_iTargets[0]].m_iOffset),
+				*(int*) (pBase + m_Fields[field.m_iTargets[1]].m_iOffset),
+				*(int*) (pBase + m_Fields[field.m_iTargets[2]].m_iOffset),
+				*(int*) (pBase + m_Fields[field.m_iTargets[3]].m_iOffset)));
+	}
+
+	return object();
+}
+
+bool CTempEntityLayout::Set(CBaseTempEntity* pTempEntity, const char* szName, object value)
+{
+	int iIndex = FindField(szName);
+	if (iIndex == -1)
+		return false;
+
+	SetField((unsigned char*) pTempEntity, m_Fields[iIndex], value);
+	return true;
+}
+
+void CTempEntityLayout::SetField(unsigned char* pBase, const TempEntityField_t& field, object value)
+{
+	switch (field.m_eType)
+	{
+		case TE_FIELD_INT:
+			*(int*) (pBase + field.m_iOffset) = extract<int>(value);
+			break;
+		case TE_FIELD_FLOAT:
+			*(float*) (pBase + field.m_iOffset) = extract<float>(value);
+			break;
+		case TE_FIELD_VECTOR:
+			*(Vector*) (pBase + field.m_iOffset) = extract<Vector&>(value);
+			break;
+		case TE_FIELD_INDEX:
+		{
+			if (!field.m_oClass.is_none())
+			{
+				int iResult = PyObject_IsInstance(value.ptr(), field.m_oClass.ptr());
+				if (iResult == -1)
+					throw_error_already_set();
+
+				if (!iResult)
+				{
+					const char* szValue = extract<const char*>(str(value));
+					const char* szClass = extract<const char*>(field.m_oClass.attr("__name__"));
+					BOOST_RAISE_EXCEPTION(PyExc_ValueError, "\"%s\" is not a valid %s instance.", szValue, szClass)
+				}
+			}
+
+			*(int*) (pBase + field.m_iOffset) = extract<int>(value.attr("index"));
+			break;
+		}
+		case TE_FIELD_COLOR:
+		{
+			extract<Color&> color(value);
+			if (!color.check())
+			{
+				const char* szValue = extract<const char*>(str(value));
+				BOOST_RAISE_EXCEPTION(PyExc_ValueError, "\"%s\" is not a valid Color instance.", szValue)
+			}
+
+			const Color& c = color();
+			*(int*) (pBase + m_Fields[field.m_iTargets[0]].m_iOffset) = c.r();
+			*(int*) (pBase + m_Fields[field.m_iTargets[1]].m_iOffset) = c.g();
+			*(int*) (pBase + m_Fields[field.m_iTargets[2]].m_iOffset) = c.b();
+			*(int*) (pBase + m_Fields[field.m_iTargets[3]].m_iOffset) = c.a();
+			break;
+		}
+	}
+}
+
+void CTempEntityLayout::Fill(object temp_entity, object aliases)
+{
+	CBaseTempEntity* pTempEntity = extract<CBaseTempEntity*>(temp_entity);
+
+	list items(aliases.attr("items")());
+	for (int i=0; i < len(items); i++)
+	{
+		object alias = items[i][0];
+		object value = items[i][1];
+
+		// Leave aliases that have not been compiled to TempEntity
+		if (!Set(pTempEntity, extract<const char*>(alias), value))
+			setattr(temp_entity, alias, value);
+	}
+}
+
+int CTempEntityLayout::CreateMany(object temp_entity, IRecipientFilter& recipients, object rows, float delay)
+{
+	CBaseTempEntity* pTempEntity = extract<CBaseTempEntity*>(temp_entity);
+
+	object iterator(handle<>(PyObject_GetIter(rows.ptr())));
+
+	int iCount = 0;
+	PyObject* pRow;
+	while ((pRow = PyIter_Next(iterator.ptr())) != NULL)
+	{
+		object row(handle<>(pRow));
+		Fill(temp_entity, row);
+		pTempEntity->Create(recipients, delay);
+		++iCount;
+	}
+
+	if (PyErr_Occurred())
+		throw_error_already_set();
+
+	return iCount;
+}
@@ -0,0 +1,115 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _EFFECTS_LAYOUT_H
+#define _EFFECTS_LAYOUT_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <string>
+#include <vector>
+
+// Boost
+#include "boost/unordered_map.hpp"
+
+// Source.Python
+#include "utilities/wrap_macros.h"
+
+// SDK
+#include "irecipientfilter.h"
+#include "game/server/basetempentity.h"
+
+
+//-----------------------------------------------------------------------------
+// Types of temp entity fields.
+//-----------------------------------------------------------------------------
+enum TempEntityFieldType_t
+{
+	TE_FIELD_INT,
+	TE_FIELD_FLOAT,
+	TE_FIELD_VECTOR,
+
+	// Aliases that store the index of the given object in another field
+	TE_FIELD_INDEX,
+
+	// Aliases that store the components of a Color in four other fields
+	TE_FIELD_COLOR
+};
+
+
+//-----------------------------------------------------------------------------
+// A compiled alias of a temp entity template.
+//-----------------------------------------------------------------------------
+struct TempEntityField_t
+{
+	TempEntityFieldType_t m_eType;
+	int m_iOffset;
+
+	// Fields the value is stored in for index and color aliases
+	int m_iTargets[4];
+
+	// Required class of values for index aliases
+	object m_oClass;
+};
+
+
+//-----------------------------------------------------------------------------
+// Reads and writes the aliases of a temp entity template natively.
+//
+// Aliases that have not been compiled are left to the Python implementation
+// of TempEntity.
+//-----------------------------------------------------------------------------
+typedef boost::unordered_map<std::string, int> TempEntityFieldMap;
+
+class CTempEntityLayout
+{
+public:
+	void AddField(const char* szName, int iOffset, const char* szType);
+	void AddIndexAlias(const char* szName, const char* szTarget, object cls);
+	void AddColorAlias(const char* szName, tuple targets);
+
+	bool Contains(const char* szName);
+	int GetCount();
+
+	object Get(CBaseTempEntity* pTempEntity, const char* szName);
+	bool Set(CBaseTempEntity* pTempEntity, const char* szName, object value);
+	void Fill(object temp_entity, object aliases);
+	int CreateMany(object temp_entity, IRecipientFilter& recipients, object rows, float delay);
+
+private:
+	int FindField(const char* szName);
+	int AddEntry(const char* szName, const TempEntityField_t& field);
+	void SetField(unsigned char* pBase, const TempEntityField_t& field, object value);
+
+private:
+	std::vector<TempEntityField_t> m_Fields;
+	TempEntityFieldMap m_FieldIndexes;
+};
+
+
+#endif // _EFFECTS_LAYOUT_H
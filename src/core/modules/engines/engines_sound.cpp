@@ -0,0 +1,581 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <string.h>
+#include "engines_sound.h"
+#include "utilities/wrap_macros.h"
+
+
+//-----------------------------------------------------------------------------
+// External variables.
+//-----------------------------------------------------------------------------
+extern IFileSystem* filesystem;
+
+
+//-----------------------------------------------------------------------------
+// MPEG audio tables.
+//-----------------------------------------------------------------------------
+// Bitrates in kbit/s by [MPEG 1 or 2/2.5][layer I, II, III][index]
+static const int s_MP3Bitrates[2][3][16] = {
+	{
+		{0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 0},
+		{0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 0},
+		{0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 0}
+	},
+	{
+		{0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256, 0},
+		{0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0},
+		{0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160, 0}
+	}
+};
+
+// Sample rates by [version bits][index]
+static const int s_MP3SampleRates[4][3] = {
+	{11025, 12000, 8000},	// MPEG 2.5
+	{0, 0, 0},				// Reserved
+	{22050, 24000, 16000},	// MPEG 2
+	{44100, 48000, 32000}	// MPEG 1
+};
+
+// Number of bytes that are searched for the first MPEG frame
+#define MP3_SYNC_SEARCH_SIZE 8192
+
+// Number of bytes at the end of an OGG file that are searched for the last page
+#define OGG_LAST_PAGE_SEARCH_SIZE 65536
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+inline unsigned int ReadLE16(const unsigned char* p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+inline unsigned int ReadLE32(const unsigned char* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+inline unsigned int ReadBE32(const unsigned char* p)
+{
+	return ((unsigned int) p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+inline std::string NormalizeSoundPath(const char* szPath)
+{
+	std::string path(szPath);
+	for (std::string::iterator it = path.begin(); it != path.end(); ++it)
+	{
+		if (*it == '\\')
+			*it = '/';
+	}
+
+	return path;
+}
+
+inline bool ReadExactly(FileHandle_t hFile, void* pOutput, int iSize)
+{
+	return filesystem->Read(pOutput, iSize, hFile) == iSize;
+}
+
+
+//-----------------------------------------------------------------------------
+// Parsers.
+//-----------------------------------------------------------------------------
+static bool ParseWave(FileHandle_t hFile, SoundInfo_t& info)
+{
+	unsigned char header[12];
+	if (!ReadExactly(hFile, header, sizeof(header)) || memcmp(header + 8, "WAVE", 4) != 0)
+		return false;
+
+	unsigned int uiByteRate = 0;
+	unsigned char chunk[16];
+	while (ReadExactly(hFile, chunk, 8))
+	{
+		unsigned int uiChunkSize = ReadLE32(chunk + 4);
+		if (memcmp(chunk, "fmt ", 4) == 0)
+		{
+			if (uiChunkSize < 16 || !ReadExactly(hFile, chunk, 16))
+				return false;
+
+			info.m_iChannels = ReadLE16(chunk + 2);
+			info.m_iSampleRate = ReadLE32(chunk + 4);
+			uiByteRate = ReadLE32(chunk + 8);
+			uiChunkSize -= 16;
+		}
+		else if (memcmp(chunk, "data", 4) == 0)
+		{
+			if (!uiByteRate)
+				return false;
+
+			info.m_iFormat = SOUND_FORMAT_WAV;
+			info.m_flDuration = (float) ((double) uiChunkSize / uiByteRate);
+			return true;
+		}
+
+		// Chunks are word aligned
+		filesystem->Seek(hFile, uiChunkSize + (uiChunkSize & 1), FILESYSTEM_SEEK_CURRENT);
+	}
+
+	return false;
+}
+
+// Returns the length of the MPEG frame with the given header or 0 if the
+// header is invalid
+static int GetMP3FrameLength(const unsigned char* p)
+{
+	if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0)
+		return 0;
+
+	int iVersion = (p[1] >> 3) & 3;
+	int iLayer = (p[1] >> 1) & 3;
+	int iBitrateIndex = p[2] >> 4;
+	int iSampleRateIndex = (p[2] >> 2) & 3;
+	if (iVersion == 1 || iLayer == 0 || iBitrateIndex == 0 || iBitrateIndex == 15 || iSampleRateIndex == 3)
+		return 0;
+
+	bool bMPEG1 = iVersion == 3;
+	int iLayerIndex = 3 - iLayer;
+	int iBitrate = s_MP3Bitrates[bMPEG1 ? 0 : 1][iLayerIndex][iBitrateIndex] * 1000;
+	int iSampleRate = s_MP3SampleRates[iVersion][iSampleRateIndex];
+	int iPadding = (p[2] >> 1) & 1;
+
+	if (iLayerIndex == 0)
+		return (12 * iBitrate / iSampleRate + iPadding) * 4;
+
+	if (iLayerIndex == 2 && !bMPEG1)
+		return 72 * iBitrate / iSampleRate + iPadding;
+
+	return 144 * iBitrate / iSampleRate + iPadding;
+}
+
+static bool ParseMP3(FileHandle_t hFile, unsigned int uiFileSize, SoundInfo_t& info)
+{
+	// Skip the ID3v2 tag
+	unsigned int uiStart = 0;
+	unsigned char tag[10];
+	if (!ReadExactly(hFile, tag, sizeof(tag)))
+		return false;
+
+	if (memcmp(tag, "ID3", 3) == 0)
+	{
+		uiStart = 10 + (((tag[6] & 0x7F) << 21) | ((tag[7] & 0x7F) << 14) | ((tag[8] & 0x7F) << 7) | (tag[9] & 0x7F));
+		if (tag[5] & 0x10)
+			uiStart += 10;
+	}
+
+	filesystem->Seek(hFile, uiStart, FILESYSTEM_SEEK_HEAD);
+
+	unsigned char buffer[MP3_SYNC_SEARCH_SIZE];
+	int iRead = filesystem->Read(buffer, sizeof(buffer), hFile);
+
+	// Find the first valid frame header. Other files can contain the sync
+	// bits as well, so a header is only accepted if the next frame starts
+	// with a matching header.
+	for (int i=0; i + 4 <= iRead; i++)
+	{
+		const unsigned char* p = buffer + i;
+		int iFrameLength = GetMP3FrameLength(p);
+		if (!iFrameLength)
+			continue;
+
+		unsigned char next[4];
+		const unsigned char* pNext = next;
+		if (i + iFrameLength + 4 <= iRead)
+		{
+			pNext = p + iFrameLength;
+		}
+		else
+		{
+			filesystem->Seek(hFile, uiStart + i + iFrameLength, FILESYSTEM_SEEK_HEAD);
+			if (!ReadExactly(hFile, next, sizeof(next)))
+				continue;
+		}
+
+		// Version, layer and sample rate must not change between frames
+		if (!GetMP3FrameLength(pNext) || (pNext[1] & 0xFE) != (p[1] & 0xFE) || (pNext[2] & 0x0C) != (p[2] & 0x0C))
+			continue;
+
+		int iVersion = (p[1] >> 3) & 3;
+		int iLayer = (p[1] >> 1) & 3;
+		int iBitrateIndex = p[2] >> 4;
+		int iSampleRateIndex = (p[2] >> 2) & 3;
+
+		bool bMPEG1 = iVersion == 3;
+		bool bMono = (p[3] >> 6) == 3;
+		int iLayerIndex = 3 - iLayer;
+		int iBitrate = s_MP3Bitrates[bMPEG1 ? 0 : 1][iLayerIndex][iBitrateIndex];
+		int iSampleRate = s_MP3SampleRates[iVersion][iSampleRateIndex];
+		int iSamplesPerFrame = iLayerIndex == 0 ? 384 : (iLayerIndex == 2 && !bMPEG1 ? 576 : 1152);
+
+		info.m_iFormat = SOUND_FORMAT_MP3;
+		info.m_iSampleRate = iSampleRate;
+		info.m_iChannels = bMono ? 1 : 2;
+
+		// Use the frame count of a Xing/Info or VBRI header if available
+		unsigned int uiFrames = 0;
+		int iXing = 4 + (bMPEG1 ? (bMono ? 17 : 32) : (bMono ? 9 : 17));
+		int iVBRI = 4 + 32;
+		if (i + iXing + 12 <= iRead && (memcmp(p + iXing, "Xing", 4) == 0 || memcmp(p + iXing, "Info", 4) == 0))
+		{
+			if (ReadBE32(p + iXing + 4) & 1)
+				uiFrames = ReadBE32(p + iXing + 8);
+		}
+		else if (i + iVBRI + 18 <= iRead && memcmp(p + iVBRI, "VBRI", 4) == 0)
+		{
+			uiFrames = ReadBE32(p + iVBRI + 14);
+		}
+
+		if (uiFrames)
+		{
+			info.m_flDuration = (float) ((double) uiFrames * iSamplesPerFrame / iSampleRate);
+		}
+		else
+		{
+			// Assume a constant bitrate
+			unsigned int uiAudioSize = uiFileSize - uiStart - i;
+			info.m_flDuration = (float) ((double) uiAudioSize * 8 / (iBitrate * 1000));
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+static bool ParseOgg(FileHandle_t hFile, unsigned int uiFileSize, SoundInfo_t& info)
+{
+	// The first page contains the Vorbis identification header
+	unsigned char page[27 + 255];
+	if (!ReadExactly(hFile, page, 27))
+		return false;
+
+	int iSegments = page[26];
+	unsigned char packet[16];
+	if (!ReadExactly(hFile, page + 27, iSegments) || !ReadExactly(hFile, packet, sizeof(packet)))
+		return false;
+
+	if (packet[0] != 1 || memcmp(packet + 1, "vorbis", 6) != 0)
+		return false;
+
+	info.m_iChannels = packet[11];
+	info.m_iSampleRate = ReadLE32(packet + 12);
+	if (!info.m_iSampleRate)
+		return false;
+
+	// The granule position of the last page is the number of samples
+	unsigned int uiSearchSize = uiFileSize < OGG_LAST_PAGE_SEARCH_SIZE ? uiFileSize : OGG_LAST_PAGE_SEARCH_SIZE;
+	unsigned char* pBuffer = new unsigned char[uiSearchSize];
+	filesystem->Seek(hFile, uiFileSize - uiSearchSize, FILESYSTEM_SEEK_HEAD);
+	int iRead = filesystem->Read(pBuffer, uiSearchSize, hFile);
+
+	unsigned long long ullGranule = 0;
+	for (int i=iRead - 14; i >= 0; i--)
+	{
+		if (memcmp(pBuffer + i, "OggS", 4) == 0)
+		{
+			ullGranule = ReadLE32(pBuffer + i + 6) | ((unsigned long long) ReadLE32(pBuffer + i + 10) << 32);
+			break;
+		}
+	}
+
+	delete[] pBuffer;
+
+	info.m_iFormat = SOUND_FORMAT_OGG;
+	info.m_flDuration = (float) ((double) ullGranule / info.m_iSampleRate);
+	return true;
+}
+
+bool ParseSoundInfo(const char* szPath, SoundInfo_t& info)
+{
+	FileHandle_t hFile = filesystem->Open(szPath, "rb");
+	if (hFile == FILESYSTEM_INVALID_HANDLE)
+		return false;
+
+	info = SoundInfo_t();
+	info.m_uiSize = filesystem->Size(hFile);
+	info.m_lTime = filesystem->GetFileTime(szPath);
+	info.m_bVerified = true;
+
+	unsigned char magic[4];
+	if (ReadExactly(hFile, magic, sizeof(magic)))
+	{
+		filesystem->Seek(hFile, 0, FILESYSTEM_SEEK_HEAD);
+
+		bool bResult;
+		if (memcmp(magic, "RIFF", 4) == 0)
+			bResult = ParseWave(hFile, info);
+		else if (memcmp(magic, "OggS", 4) == 0)
+			bResult = ParseOgg(hFile, info.m_uiSize, info);
+		else
+			bResult = ParseMP3(hFile, info.m_uiSize, info);
+
+		// Unsupported or corrupt files are stored with an unknown format,
+		// so they are not parsed again until they change
+		if (!bResult)
+			info.m_iFormat = SOUND_FORMAT_UNKNOWN;
+	}
+
+	filesystem->Close(hFile);
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// CSoundInfoIndex class.
+//-----------------------------------------------------------------------------
+CSoundInfoIndex::CSoundInfoIndex()
+{
+	m_bStop = false;
+	m_bModified = false;
+}
+
+SoundInfo_t CSoundInfoIndex::Get(const char* szPath)
+{
+	std::string path = NormalizeSoundPath(szPath);
+
+	SoundInfo_t info;
+	bool bFound = Lookup(path, info);
+	if (!bFound || !info.m_bVerified)
+	{
+		if (!Update(path, info))
+			BOOST_RAISE_EXCEPTION(PyExc_IOError, "Unable to open sound file \"%s\".", szPath)
+	}
+
+	if (info.m_iFormat == SOUND_FORMAT_UNKNOWN)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Unsupported sound file \"%s\".", szPath)
+
+	return info;
+}
+
+bool CSoundInfoIndex::Contains(const char* szPath)
+{
+	SoundInfo_t info;
+	return Lookup(NormalizeSoundPath(szPath), info);
+}
+
+void CSoundInfoIndex::Queue(const char* szPath)
+{
+	{
+		AUTO_LOCK(m_Mutex);
+		m_Queue.push_back(NormalizeSoundPath(szPath));
+	}
+
+	// The parser thread is only started if it's actually required
+	if (!IsAlive())
+	{
+		m_bStop = false;
+		Start();
+	}
+
+	m_Wake.Set();
+}
+
+void CSoundInfoIndex::Clear()
+{
+	AUTO_LOCK(m_Mutex);
+	m_Entries.clear();
+	m_bModified = true;
+}
+
+int CSoundInfoIndex::GetCount()
+{
+	AUTO_LOCK(m_Mutex);
+	return m_Entries.size();
+}
+
+int CSoundInfoIndex::GetPending()
+{
+	AUTO_LOCK(m_Mutex);
+	return m_Queue.size();
+}
+
+bool CSoundInfoIndex::Lookup(const std::string& path, SoundInfo_t& info)
+{
+	AUTO_LOCK(m_Mutex);
+	SoundInfoMap::iterator it = m_Entries.find(path);
+	if (it == m_Entries.end())
+		return false;
+
+	info = it->second;
+	return true;
+}
+
+bool CSoundInfoIndex::Update(const std::string& path, SoundInfo_t& info)
+{
+	// Entries of an index file only need to be compared with the file
+	if (!info.m_bVerified && info.m_lTime != 0
+		&& info.m_uiSize == filesystem->Size(path.c_str())
+		&& info.m_lTime == filesystem->GetFileTime(path.c_str()))
+	{
+		info.m_bVerified = true;
+
+		AUTO_LOCK(m_Mutex);
+		m_Entries[path] = info;
+		return true;
+	}
+
+	// Parse the file without holding the lock
+	bool bResult = ParseSoundInfo(path.c_str(), info);
+
+	AUTO_LOCK(m_Mutex);
+	if (bResult)
+		m_Entries[path] = info;
+	else
+		m_Entries.erase(path);
+
+	m_bModified = true;
+	return bResult;
+}
+
+int CSoundInfoIndex::Run()
+{
+	while (!m_bStop)
+	{
+		std::string path;
+		{
+			AUTO_LOCK(m_Mutex);
+			if (!m_Queue.empty())
+			{
+				path = m_Queue.front();
+				m_Queue.pop_front();
+			}
+		}
+
+		if (path.empty())
+		{
+			m_Wake.Wait(SOUND_INFO_PARSER_INTERVAL);
+			continue;
+		}
+
+		SoundInfo_t info;
+		if (!Lookup(path, info) || !info.m_bVerified)
+			Update(path, info);
+	}
+
+	return 0;
+}
+
+void CSoundInfoIndex::Shutdown()
+{
+	if (IsAlive())
+	{
+		m_bStop = true;
+		m_Wake.Set();
+		Join();
+	}
+
+	AUTO_LOCK(m_Mutex);
+	m_Queue.clear();
+}
+
+void CSoundInfoIndex::Load(const char* szFile)
+{
+	FILE* pFile = fopen(szFile, "rb");
+	if (!pFile)
+		BOOST_RAISE_EXCEPTION(PyExc_IOError, "Unable to open sound info index \"%s\".", szFile)
+
+	unsigned int header[3];
+	if (fread(header, sizeof(header), 1, pFile) != 1
+		|| header[0] != SOUND_INFO_INDEX_MAGIC || header[1] != SOUND_INFO_INDEX_VERSION)
+	{
+		fclose(pFile);
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid sound info index \"%s\".", szFile)
+	}
+
+	AUTO_LOCK(m_Mutex);
+	for (unsigned int i=0; i < header[2]; i++)
+	{
+		unsigned short usLength;
+		char szPath[MAX_PATH];
+		SoundInfo_t info;
+		long long llTime;
+		if (fread(&usLength, sizeof(usLength), 1, pFile) != 1 || usLength >= MAX_PATH
+			|| fread(szPath, usLength, 1, pFile) != 1
+			|| fread(&info.m_iFormat, sizeof(info.m_iFormat), 1, pFile) != 1
+			|| fread(&info.m_flDuration, sizeof(info.m_flDuration), 1, pFile) != 1
+			|| fread(&info.m_iSampleRate, sizeof(info.m_iSampleRate), 1, pFile) != 1
+			|| fread(&info.m_iChannels, sizeof(info.m_iChannels), 1, pFile) != 1
+			|| fread(&info.m_uiSize, sizeof(info.m_uiSize), 1, pFile) != 1
+			|| fread(&llTime, sizeof(llTime), 1, pFile) != 1)
+		{
+			break;
+		}
+
+		szPath[usLength] = '\0';
+		info.m_lTime = (long) llTime;
+
+		// Entries that have already been parsed are more recent
+		m_Entries.insert(std::make_pair(std::string(szPath), info));
+	}
+
+	fclose(pFile);
+}
+
+void CSoundInfoIndex::Save(const char* szFile)
+{
+	FILE* pFile = fopen(szFile, "wb");
+	if (!pFile)
+		BOOST_RAISE_EXCEPTION(PyExc_IOError, "Unable to open sound info index \"%s\".", szFile)
+
+	AUTO_LOCK(m_Mutex);
+	unsigned int header[3] = {SOUND_INFO_INDEX_MAGIC, SOUND_INFO_INDEX_VERSION, (unsigned int) m_Entries.size()};
+	fwrite(header, sizeof(header), 1, pFile);
+
+	for (SoundInfoMap::iterator it = m_Entries.begin(); it != m_Entries.end(); ++it)
+	{
+		const SoundInfo_t& info = it->second;
+		unsigned short usLength = (unsigned short) it->first.size();
+		long long llTime = info.m_lTime;
+
+		fwrite(&usLength, sizeof(usLength), 1, pFile);
+		fwrite(it->first.c_str(), usLength, 1, pFile);
+		fwrite(&info.m_iFormat, sizeof(info.m_iFormat), 1, pFile);
+		fwrite(&info.m_flDuration, sizeof(info.m_flDuration), 1, pFile);
+		fwrite(&info.m_iSampleRate, sizeof(info.m_iSampleRate), 1, pFile);
+		fwrite(&info.m_iChannels, sizeof(info.m_iChannels), 1, pFile);
+		fwrite(&info.m_uiSize, sizeof(info.m_uiSize), 1, pFile);
+		fwrite(&llTime, sizeof(llTime), 1, pFile);
+	}
+
+	fclose(pFile);
+	m_bModified = false;
+}
+
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+CSoundInfoIndex* GetSoundInfoIndex()
+{
+	static CSoundInfoIndex* s_pSoundInfoIndex = new CSoundInfoIndex();
+	return s_pSoundInfoIndex;
+}
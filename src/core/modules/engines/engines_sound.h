@@ -0,0 +1,154 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _ENGINES_SOUND_H
+#define _ENGINES_SOUND_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <deque>
+#include <string>
+
+// Boost
+#include "boost/unordered_map.hpp"
+
+// SDK
+#include "tier0/threadtools.h"
+#include "public/filesystem.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// Identifies index files written by CSoundInfoIndex::Save()
+#define SOUND_INFO_INDEX_MAGIC 0x49535053 // "SPSI"
+#define SOUND_INFO_INDEX_VERSION 1
+
+// Milliseconds the parser thread waits for new paths before it checks
+// the queue again
+#define SOUND_INFO_PARSER_INTERVAL 500
+
+
+//-----------------------------------------------------------------------------
+// Sound formats.
+//-----------------------------------------------------------------------------
+enum SoundFormat_t
+{
+	SOUND_FORMAT_UNKNOWN = 0,
+	SOUND_FORMAT_WAV,
+	SOUND_FORMAT_MP3,
+	SOUND_FORMAT_OGG
+};
+
+
+//-----------------------------------------------------------------------------
+// Header information of a sound file.
+//-----------------------------------------------------------------------------
+struct SoundInfo_t
+{
+	SoundInfo_t():
+		m_iFormat(SOUND_FORMAT_UNKNOWN),
+		m_flDuration(0),
+		m_iSampleRate(0),
+		m_iChannels(0),
+		m_uiSize(0),
+		m_lTime(0),
+		m_bVerified(false)
+	{
+	}
+
+	SoundFormat_t GetFormat() { return (SoundFormat_t) m_iFormat; }
+
+	int m_iFormat;
+	float m_flDuration;
+	int m_iSampleRate;
+	int m_iChannels;
+
+	// Size and modification time of the file when it was parsed
+	unsigned int m_uiSize;
+	long m_lTime;
+
+	// False for entries that have been loaded from an index file and have
+	// not been compared with the file yet
+	bool m_bVerified;
+};
+
+
+//-----------------------------------------------------------------------------
+// Functions.
+//-----------------------------------------------------------------------------
+// Parses the header of a WAV, MP3 or OGG file in the game's file system.
+bool ParseSoundInfo(const char* szPath, SoundInfo_t& info);
+
+
+//-----------------------------------------------------------------------------
+// Stores the header information of sound files by path.
+//
+// Paths can be queued to be parsed by a background thread. Each entry
+// remembers the size and modification time of its file, so it's parsed
+// again after the file has been changed.
+//-----------------------------------------------------------------------------
+typedef boost::unordered_map<std::string, SoundInfo_t> SoundInfoMap;
+
+class CSoundInfoIndex: public CThread
+{
+public:
+	CSoundInfoIndex();
+
+	SoundInfo_t Get(const char* szPath);
+	bool Contains(const char* szPath);
+	void Queue(const char* szPath);
+	void Clear();
+	int GetCount();
+	int GetPending();
+	bool IsModified() { return m_bModified; }
+
+	void Load(const char* szFile);
+	void Save(const char* szFile);
+	void Shutdown();
+
+protected:
+	virtual int Run();
+
+private:
+	bool Lookup(const std::string& path, SoundInfo_t& info);
+	bool Update(const std::string& path, SoundInfo_t& info);
+
+private:
+	SoundInfoMap m_Entries;
+	std::deque<std::string> m_Queue;
+	CThreadMutex m_Mutex;
+	CThreadEvent m_Wake;
+	volatile bool m_bStop;
+	volatile bool m_bModified;
+};
+
+CSoundInfoIndex* GetSoundInfoIndex();
+
+
+#endif // _ENGINES_SOUND_H
@@ -31,6 +31,7 @@
 #include "export_main.h"
 #include "utilities/conversions.h"
 #include "engines.h"
+#include "engines_sound.h"
 #include ENGINE_INCLUDE_PATH(engines_wrap.h)
 
 // SDK
@@ -52,6 +53,9 @@ void export_global_sound_variables(scope);
 void export_attenuation(scope);
 void export_sound_flags_t(scope);
 void export_pitch(scope);
+void export_sound_format(scope);
+void export_sound_info(scope);
+void export_sound_info_index(scope);
 
 
 //---------------------------------------------------------------------------------
@@ -65,6 +69,9 @@ DECLARE_SP_SUBMODULE(_engines, _sound)
 	export_attenuation(_sound);
 	export_sound_flags_t(_sound);
 	export_pitch(_sound);
+	export_sound_format(_sound);
+	export_sound_info(_sound);
+	export_sound_info_index(_sound);
 }
 
 
@@ -213,3 +220,155 @@ void export_pitch(scope _sound)
 	_Pitch.value("LOW", (Pitch) PITCH_LOW);
 	_Pitch.value("HIGH", (Pitch) PITCH_HIGH);
 }
+
+
+//---------------------------------------------------------------------------------
+// Exports SoundFormat_t.
+//---------------------------------------------------------------------------------
+void export_sound_format(scope _sound)
+{
+	enum_<SoundFormat_t> _SoundFormat("SoundFormat");
+
+	_SoundFormat.value("UNKNOWN", SOUND_FORMAT_UNKNOWN);
+	_SoundFormat.value("WAV", SOUND_FORMAT_WAV);
+	_SoundFormat.value("MP3", SOUND_FORMAT_MP3);
+	_SoundFormat.value("OGG", SOUND_FORMAT_OGG);
+}
+
+
+//---------------------------------------------------------------------------------
+// Exports SoundInfo_t.
+//---------------------------------------------------------------------------------
+void export_sound_info(scope _sound)
+{
+	class_<SoundInfo_t> SoundInfo("SoundInfo", no_init);
+
+	SoundInfo.add_property(
+		"format",
+		&SoundInfo_t::GetFormat,
+		"Return the format of the sound file.\n\n"
+		":rtype: SoundFormat"
+	);
+
+	SoundInfo.def_readonly(
+		"duration",
+		&SoundInfo_t::m_flDuration,
+		"Return the duration in seconds.\n\n"
+		":rtype: float"
+	);
+
+	SoundInfo.def_readonly(
+		"sample_rate",
+		&SoundInfo_t::m_iSampleRate,
+		"Return the number of samples per second.\n\n"
+		":rtype: int"
+	);
+
+	SoundInfo.def_readonly(
+		"channels",
+		&SoundInfo_t::m_iChannels,
+		"Return the number of channels.\n\n"
+		":rtype: int"
+	);
+
+	SoundInfo.def_readonly(
+		"size",
+		&SoundInfo_t::m_uiSize,
+		"Return the size of the file in bytes when it was parsed.\n\n"
+		":rtype: int"
+	);
+
+	SoundInfo.def_readonly(
+		"time",
+		&SoundInfo_t::m_lTime,
+		"Return the modification time of the file when it was parsed.\n\n"
+		":rtype: int"
+	);
+}
+
+
+//---------------------------------------------------------------------------------
+// Exports CSoundInfoIndex.
+//---------------------------------------------------------------------------------
+void export_sound_info_index(scope _sound)
+{
+	class_<CSoundInfoIndex, boost::noncopyable> SoundInfoIndex("SoundInfoIndex", no_init);
+
+	SoundInfoIndex.def(
+		"get",
+		&CSoundInfoIndex::Get,
+		(arg("path")),
+		"Return the header information of a sound file.\n\n"
+		"If the file has not been parsed yet or has changed since, it's parsed immediately.\n\n"
+		":param str path: Path to the file relative to the game directory.\n"
+		":raise IOError: Raised if the file could not be opened.\n"
+		":raise ValueError: Raised if the format of the file is not supported.\n"
+		":rtype: SoundInfo"
+	);
+
+	SoundInfoIndex.def(
+		"queue",
+		&CSoundInfoIndex::Queue,
+		(arg("path")),
+		"Parse a sound file on a background thread.\n\n"
+		":param str path: Path to the file relative to the game directory."
+	);
+
+	SoundInfoIndex.def(
+		"__contains__",
+		&CSoundInfoIndex::Contains,
+		(arg("path")),
+		"Return whether the index contains an entry for the given path.\n\n"
+		":rtype: bool"
+	);
+
+	SoundInfoIndex.def(
+		"__len__",
+		&CSoundInfoIndex::GetCount,
+		"Return the number of entries.\n\n"
+		":rtype: int"
+	);
+
+	SoundInfoIndex.def(
+		"clear",
+		&CSoundInfoIndex::Clear,
+		"Remove all entries."
+	);
+
+	SoundInfoIndex.add_property(
+		"pending",
+		&CSoundInfoIndex::GetPending,
+		"Return the number of queued paths that have not been parsed yet.\n\n"
+		":rtype: int"
+	);
+
+	SoundInfoIndex.add_property(
+		"modified",
+		&CSoundInfoIndex::IsModified,
+		"Return whether entries have been changed since the index has been loaded or saved.\n\n"
+		":rtype: bool"
+	);
+
+	SoundInfoIndex.def(
+		"load",
+		&CSoundInfoIndex::Load,
+		(arg("file_path")),
+		"Add the entries of an index file.\n\n"
+		"The entries are compared with their files before they are used the first time."
+	);
+
+	SoundInfoIndex.def(
+		"save",
+		&CSoundInfoIndex::Save,
+		(arg("file_path")),
+		"Write all entries to an index file."
+	);
+
+	SoundInfoIndex.def(
+		"shutdown",
+		&CSoundInfoIndex::Shutdown,
+		"Stop the background thread. Queued paths that have not been parsed are discarded."
+	);
+
+	_sound.attr("sound_info_index") = object(ptr(GetSoundInfoIndex()));
+}
@@ -30,8 +30,12 @@
 // Boost
 #include "boost/unordered_map.hpp"
 
+// SDK
+#include "tier1/strtools.h"
+
 // Source.Python
 #include "utilities/conversions.h"
+#include "entities_entity.h"
 
 #include "entities_datamaps.h"
 #include ENGINE_INCLUDE_PATH(entities_datamaps_wrap.h)
@@ -41,56 +45,97 @@
 // >> TYPEDEFS
 // ============================================================================
 typedef boost::unordered_map<std::string, int> OffsetsMap;
-typedef boost::unordered_map<std::string, OffsetsMap > DataMapsMap;
+typedef boost::unordered_map<std::string, typedescription_t*> DescriptorsMap;
 
+struct DataMapIndex_t
+{
+	// Field names, external names and dotted names of embedded fields.
+	DescriptorsMap m_Descriptors;
 
-// ============================================================================
-// >> GLOBAL VARIABLES
-// ============================================================================
-DataMapsMap g_DataMapsCache;
+	// Offsets of all fields that are not embedded tables.
+	OffsetsMap m_Offsets;
+};
+
+typedef boost::unordered_map<datamap_t*, DataMapIndex_t> DataMapIndexMap;
 
 
 // ============================================================================
-// >> FORWARD DECLARATIONS
+// >> GLOBAL VARIABLES
 // ============================================================================
-void AddDataMap(datamap_t* pDataMap, OffsetsMap& offsets, int offset=0, const char* baseName=NULL);
+DataMapIndexMap g_DataMapIndexes;
 
 
 // ============================================================================
 // >> FUNCTIONS
 // ============================================================================
-void AddDataDesc(typedescription_t& dataDesc, OffsetsMap& offsets, int offset, const char* baseName)
+void AddDescriptorName(DataMapIndex_t& index, const char* szName, typedescription_t* pDataDesc)
 {
-	if (dataDesc.fieldName == NULL)
-		return;
+	// Don't overwrite existing names, so the first match wins like in a
+	// linear search.
+	if (szName)
+		index.m_Descriptors.insert(std::make_pair(szName, pDataDesc));
+}
 
-	int currentOffset = offset + TypeDescriptionExt::get_offset(dataDesc);
+void AddDataMap(datamap_t* pDataMap, DataMapIndex_t& index, int offset, const std::string& baseName)
+{
+	for (int i=0; i < pDataMap->dataNumFields; i++)
+	{
+		typedescription_t& dataDesc = pDataMap->dataDesc[i];
+		AddDescriptorName(index, dataDesc.fieldName, &dataDesc);
+		AddDescriptorName(index, dataDesc.externalName, &dataDesc);
 
-	char* currentName = NULL;
-	if (baseName == NULL) {
-		currentName = (char*) dataDesc.fieldName;
-	}
-	else {
-		char tempName[256];
-		sprintf(tempName, "%s.%s", baseName, dataDesc.fieldName);
-		currentName = strdup(tempName);
-	}
+		if (dataDesc.fieldName == NULL)
+			continue;
 
-	if (dataDesc.fieldType == FIELD_EMBEDDED)
-	{
-		AddDataMap(dataDesc.td, offsets, currentOffset, currentName);
-	}
-	else
-	{
-		offsets.insert(std::make_pair(currentName, currentOffset));
+		std::string currentName = dataDesc.fieldName;
+		if (!baseName.empty())
+		{
+			currentName = baseName + "." + currentName;
+			AddDescriptorName(index, currentName.c_str(), &dataDesc);
+		}
+
+		int currentOffset = offset + TypeDescriptionExt::get_offset(dataDesc);
+		if (dataDesc.fieldType == FIELD_EMBEDDED)
+		{
+			AddDataMap(dataDesc.td, index, currentOffset, currentName);
+		}
+		else
+		{
+			index.m_Offsets.insert(std::make_pair(currentName, currentOffset));
+		}
 	}
 }
 
-void AddDataMap(datamap_t* pDataMap, OffsetsMap& offsets, int offset, const char* baseName)
+DataMapIndex_t& GetDataMapIndex(datamap_t* pDataMap)
+{
+	DataMapIndexMap::iterator it = g_DataMapIndexes.find(pDataMap);
+	if (it != g_DataMapIndexes.end())
+		return it->second;
+
+	DataMapIndex_t& index = g_DataMapIndexes[pDataMap];
+	AddDataMap(pDataMap, index, 0, std::string());
+	return index;
+}
+
+void AddDescriptors(datamap_t* pDataMap, int iFlags, list& result, int offset=0, const std::string& baseName=std::string())
 {
 	for (int i=0; i < pDataMap->dataNumFields; i++)
 	{
-		AddDataDesc(pDataMap->dataDesc[i], offsets, offset, baseName);
+		typedescription_t& dataDesc = pDataMap->dataDesc[i];
+		const char* szName = dataDesc.externalName ? dataDesc.externalName : dataDesc.fieldName;
+		if (szName == NULL)
+			continue;
+
+		std::string currentName = baseName + szName;
+		int currentOffset = offset + TypeDescriptionExt::get_offset(dataDesc);
+		if (dataDesc.fieldType == FIELD_EMBEDDED)
+		{
+			AddDescriptors(dataDesc.td, iFlags, result, currentOffset, currentName + ".");
+		}
+		else if (!iFlags || (dataDesc.flags & iFlags))
+		{
+			result.append(make_tuple(currentName, ptr(&dataDesc), currentOffset));
+		}
 	}
 }
 
@@ -111,23 +156,11 @@ typedescription_t* DataMapSharedExt::find(datamap_t* pDataMap, const char *szNam
 {
 	while (pDataMap)
 	{
-		for (int iCurrentIndex=0; iCurrentIndex < pDataMap->dataNumFields; iCurrentIndex++)
-		{
-			typedescription_t& pCurrentDataDesc = pDataMap->dataDesc[iCurrentIndex];
-			if ((pCurrentDataDesc.fieldName && strcmp(szName, pCurrentDataDesc.fieldName) == 0) ||
-				(pCurrentDataDesc.externalName && strcmp(szName, pCurrentDataDesc.externalName) == 0))
-			{
-				return &(pDataMap->dataDesc[iCurrentIndex]);
-			}
-			else if (pCurrentDataDesc.fieldType == FIELD_EMBEDDED)
-			{
-				typedescription_t *pReturnValue = find(pCurrentDataDesc.td, szName);
-				if (pReturnValue)
-				{
-					return pReturnValue;
-				}
-			}
-		}
+		DataMapIndex_t& index = GetDataMapIndex(pDataMap);
+		DescriptorsMap::iterator result = index.m_Descriptors.find(szName);
+		if (result != index.m_Descriptors.end())
+			return result->second;
+
 		pDataMap = pDataMap->baseMap;
 	}
 	return NULL;
@@ -137,25 +170,23 @@ int DataMapSharedExt::find_offset(datamap_t* pDataMap, const char* name)
 {
 	while (pDataMap)
 	{
-		DataMapsMap::iterator offsets = g_DataMapsCache.find(pDataMap->dataClassName);
-		if (offsets == g_DataMapsCache.end())
-		{
-			offsets = g_DataMapsCache.insert(std::make_pair(pDataMap->dataClassName, OffsetsMap())).first;
-			AddDataMap(pDataMap, offsets->second);
-		}
-		
-		OffsetsMap::iterator result = offsets->second.find(name);
-		if (result == offsets->second.end())
-		{
-			pDataMap = pDataMap->baseMap;
-		}
-		else {
+		DataMapIndex_t& index = GetDataMapIndex(pDataMap);
+		OffsetsMap::iterator result = index.m_Offsets.find(name);
+		if (result != index.m_Offsets.end())
 			return result->second;
-		}
+
+		pDataMap = pDataMap->baseMap;
 	}
 	return -1;
 }
 
+list DataMapSharedExt::get_descriptors(datamap_t* pDataMap, int iFlags)
+{
+	list result;
+	AddDescriptors(pDataMap, iFlags, result);
+	return result;
+}
+
 
 // ============================================================================
 // >> TypeDescriptionSharedExt
@@ -223,47 +254,120 @@ CInputFunction::CInputFunction(typedescription_t pTypeDesc, CFunction &pFunc, CB
 void CInputFunction::__call__(object value, CBaseEntity *pActivator, CBaseEntity *pCaller)
 {
 	inputdata_t pInputData;
+	SetValue(pInputData.value, m_pTypeDesc, value);
+
+	pInputData.pActivator = pActivator;
+	pInputData.pCaller = pCaller;
+
+	(m_pBaseEntity->*m_pTypeDesc.inputFunc)(pInputData);
+}
+
+void CInputFunction::SetValue(variant_t& variant, const typedescription_t& pTypeDesc, object value)
+{
+	if (pTypeDesc.fieldType == FIELD_VOID)
+		return;
+
+	if (value.is_none())
+		BOOST_RAISE_EXCEPTION(
+			PyExc_ValueError,
+			"Must provide a value for \"%s\".", pTypeDesc.externalName
+		);
 
-	if (m_pTypeDesc.fieldType != FIELD_VOID)
+	switch (pTypeDesc.fieldType)
 	{
-		if (value.is_none())
+		case FIELD_BOOLEAN:
+			variant.SetBool(extract<bool>(value));
+			break;
+		case FIELD_COLOR32:
+			VariantExt::set_color(&variant, extract<Color *>(value));
+			break;
+		case FIELD_FLOAT:
+			variant.SetFloat(extract<float>(value));
+			break;
+		case FIELD_INTEGER:
+			variant.SetInt(extract<int>(value));
+			break;
+		case FIELD_STRING:
+			VariantExt::set_string(&variant, extract<const char *>(value));
+			break;
+		case FIELD_CLASSPTR:
+			variant.SetEntity(extract<CBaseEntity *>(value));
+			break;
+		default:
 			BOOST_RAISE_EXCEPTION(
-				PyExc_ValueError,
-				"Must provide a value for \"%s\".", m_pTypeDesc.externalName
+				PyExc_TypeError,
+				"Unsupported type for input \"%s\".", pTypeDesc.externalName
 			);
+	}
+}
 
-		switch (m_pTypeDesc.fieldType)
+static typedescription_t* FindInput(datamap_t* pDataMap, const char* szInput)
+{
+	for (; pDataMap; pDataMap = pDataMap->baseMap)
+	{
+		for (int i=0; i < pDataMap->dataNumFields; ++i)
 		{
-			case FIELD_BOOLEAN:
-				pInputData.value.SetBool(extract<bool>(value));
-				break;
-			case FIELD_COLOR32:
-				VariantExt::set_color(&pInputData.value, extract<Color *>(value));
-				break;
-			case FIELD_FLOAT:
-				pInputData.value.SetFloat(extract<float>(value));
-				break;
-			case FIELD_INTEGER:
-				pInputData.value.SetInt(extract<int>(value));
-				break;
-			case FIELD_STRING:
-				VariantExt::set_string(&pInputData.value, extract<const char *>(value));
-				break;
-			case FIELD_CLASSPTR:
-				pInputData.value.SetEntity(extract<CBaseEntity *>(value));
-				break;
-			default:
-				BOOST_RAISE_EXCEPTION(
-					PyExc_TypeError,
-					"Unsupported type for input \"%s\".", m_pTypeDesc.externalName
-				);
+			typedescription_t& pTypeDesc = pDataMap->dataDesc[i];
+			if ((pTypeDesc.flags & FTYPEDESC_INPUT) && pTypeDesc.externalName
+				&& V_stricmp(pTypeDesc.externalName, szInput) == 0)
+				return &pTypeDesc;
 		}
 	}
 
+	return NULL;
+}
+
+int CInputFunction::CallMany(object indexes, const char* szInput, object value,
+	CBaseEntity *pActivator, CBaseEntity *pCaller)
+{
+	// Entities of the same class share their datamap, so each class only
+	// needs to be searched once
+	boost::unordered_map<datamap_t*, typedescription_t*> inputs;
+
+	// Values are only converted once per input type
+	boost::unordered_map<int, variant_t> values;
+
+	inputdata_t pInputData;
 	pInputData.pActivator = pActivator;
 	pInputData.pCaller = pCaller;
 
-	(m_pBaseEntity->*m_pTypeDesc.inputFunc)(pInputData);
+	int iCalls = 0;
+	list items(indexes);
+	for (int i=0; i < len(items); ++i)
+	{
+		// Previous inputs might have removed the entity
+		CBaseEntity* pEntity;
+		if (!BaseEntityFromIndex(extract<unsigned int>(items[i]), pEntity))
+			continue;
+
+		datamap_t* pDataMap = ((CBaseEntityWrapper *) pEntity)->GetDataDescMap();
+		typedescription_t* pTypeDesc;
+
+		boost::unordered_map<datamap_t*, typedescription_t*>::iterator input = inputs.find(pDataMap);
+		if (input != inputs.end())
+			pTypeDesc = input->second;
+		else
+			pTypeDesc = inputs[pDataMap] = FindInput(pDataMap, szInput);
+
+		// The entity doesn't have this input
+		if (!pTypeDesc)
+			continue;
+
+		boost::unordered_map<int, variant_t>::iterator variant = values.find(pTypeDesc->fieldType);
+		if (variant == values.end())
+		{
+			variant_t newValue;
+			SetValue(newValue, *pTypeDesc, value);
+			variant = values.insert(std::make_pair((int) pTypeDesc->fieldType, newValue)).first;
+		}
+
+		pInputData.value = variant->second;
+		pInputData.nOutputID = 0;
+		(pEntity->*pTypeDesc->inputFunc)(pInputData);
+		++iCalls;
+	}
+
+	return iCalls;
 }
 
 
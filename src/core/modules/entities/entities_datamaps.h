@@ -55,6 +55,7 @@ public:
 	static typedescription_t& __getitem__(const datamap_t& pDataMap, int iIndex);
 	static typedescription_t* find(datamap_t* pDataMap, const char *szName);
 	static int find_offset(datamap_t* pDataMap, const char* name);
+	static list get_descriptors(datamap_t* pDataMap, int iFlags);
 };
 
 
@@ -92,6 +93,13 @@ public:
 	CInputFunction(typedescription_t pTypeDesc, CFunction &pFunc, CBaseEntity *pBaseEntity);
 	void __call__(object value, CBaseEntity *pActivator, CBaseEntity *pCaller);
 
+	// Converts the value to the type of the given input
+	static void SetValue(variant_t& variant, const typedescription_t& pTypeDesc, object value);
+
+	// Calls an input on all given entities and returns the number of calls
+	static int CallMany(object indexes, const char* szInput, object value,
+		CBaseEntity *pActivator, CBaseEntity *pCaller);
+
 public:
 	typedescription_t m_pTypeDesc;
 	CBaseEntity *m_pBaseEntity;
@@ -141,6 +141,16 @@ void export_datamap(scope _datamaps)
 		":rtype: int"
 	);
 
+	DataMap.def("get_descriptors",
+		&DataMapSharedExt::get_descriptors,
+		(arg("flags")=0),
+		"Return the type descriptions of this data map without the ones of its base data maps.\n\n"
+		"Embedded data maps are resolved and their descriptions are prefixed with the name of the embedded field and a dot.\n\n"
+		":param int flags: If not 0, only type descriptions with at least one of the given :class:`TypeDescriptionFlags` are returned.\n"
+		":return: A list of tuples containing the name, the :class:`TypeDescription` and the offset of each description.\n"
+		":rtype: list"
+	);
+
 	// Engine specific stuff...
 	export_engine_specific_datamap(_datamaps, DataMap);
 
@@ -268,6 +278,34 @@ void export_input_function(scope _datamaps)
 		"	If the type of the input is unsupported.",
 		("self", arg("value")=object(), arg("activator")=object(), arg("caller")=object())
 	);
+
+	def("call_input_many",
+		&CInputFunction::CallMany,
+		"Call an input on all given entities.\n"
+		"\n"
+		"The input is looked up once per entity class and the value is only converted once.\n"
+		"Entities that don't exist or don't have the input are skipped.\n"
+		"\n"
+		":param iterable indexes:\n"
+		"	Indexes of the entities.\n"
+		":param str input_name:\n"
+		"	Name of the input.\n"
+		":param object value:\n"
+		"	The value to pass to the input function.\n"
+		":param BaseEntity activator:\n"
+		"	The activator entity.\n"
+		":param BaseEntity caller:\n"
+		"	The caller entity.\n"
+		":return:\n"
+		"	The number of entities the input has been called on.\n"
+		":rtype: int\n"
+		"\n"
+		":raises ValueError:\n"
+		"	If the given value is not valid for that input.\n"
+		":raises TypeError:\n"
+		"	If the type of the input is unsupported.",
+		(arg("indexes"), arg("input_name"), arg("value")=object(), arg("activator")=object(), arg("caller")=object())
+	);
 }
 
 
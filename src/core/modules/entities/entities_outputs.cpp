@@ -0,0 +1,256 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <algorithm>
+
+// Source.Python
+#include "entities_outputs.h"
+#include "entities_helpers.h"
+#include "modules/memory/memory_function.h"
+#include "modules/memory/memory_pointer.h"
+#include "utilities/wrap_macros.h"
+
+// SDK
+#include "tier1/strtools.h"
+
+
+//-----------------------------------------------------------------------------
+// Global variables.
+//-----------------------------------------------------------------------------
+CEntityOutputRegistry g_EntityOutputRegistry;
+
+
+//-----------------------------------------------------------------------------
+// CBaseEntityOutput::FireOutput hook.
+//-----------------------------------------------------------------------------
+bool PreFireOutput(HookType_t eHookType, CHook* pHook)
+{
+	return g_EntityOutputRegistry.Dispatch(pHook);
+}
+
+
+//-----------------------------------------------------------------------------
+// Helper functions.
+//-----------------------------------------------------------------------------
+inline std::string ToLower(const char* szValue)
+{
+	std::string result(szValue);
+	std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+	return result;
+}
+
+inline std::string ExtractOptionalString(object oValue)
+{
+	if (oValue.is_none())
+		return std::string();
+
+	return extract<std::string>(oValue);
+}
+
+
+//-----------------------------------------------------------------------------
+// CEntityOutputRegistry.
+//-----------------------------------------------------------------------------
+CEntityOutputRegistry::CEntityOutputRegistry()
+{
+	m_bHooked = false;
+}
+
+void CEntityOutputRegistry::Register(object oCallback, object oOutput, object oClassname, object oTargetName)
+{
+	if (!PyCallable_Check(oCallback.ptr()))
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "The callback is not callable.")
+
+	EntityOutputCallback_t callback;
+	callback.m_oCallback = oCallback;
+	callback.m_Classname = ExtractOptionalString(oClassname);
+	callback.m_TargetName = ExtractOptionalString(oTargetName);
+	GetCallbacks(oOutput).push_back(callback);
+
+	Hook();
+}
+
+void CEntityOutputRegistry::Unregister(object oCallback, object oOutput, object oClassname, object oTargetName)
+{
+	std::string classname = ExtractOptionalString(oClassname);
+	std::string targetname = ExtractOptionalString(oTargetName);
+
+	EntityOutputCallbackList& callbacks = GetCallbacks(oOutput);
+	for (EntityOutputCallbackList::iterator it=callbacks.begin(); it != callbacks.end();)
+	{
+		if (it->m_oCallback == oCallback && it->m_Classname == classname && it->m_TargetName == targetname)
+			it = callbacks.erase(it);
+		else
+			++it;
+	}
+
+	// Don't keep empty lists, so unregistered outputs are skipped by a
+	// single lookup
+	if (!oOutput.is_none() && callbacks.empty())
+		m_Outputs.erase(ToLower(extract<const char*>(oOutput)));
+}
+
+bool CEntityOutputRegistry::IsRegistered(const char* szOutput)
+{
+	return !m_AnyOutput.empty() || m_Outputs.find(ToLower(szOutput)) != m_Outputs.end();
+}
+
+int CEntityOutputRegistry::GetCount()
+{
+	int iCount = (int) m_AnyOutput.size();
+	for (EntityOutputMap::iterator it=m_Outputs.begin(); it != m_Outputs.end(); ++it)
+		iCount += (int) it->second.size();
+
+	return iCount;
+}
+
+void CEntityOutputRegistry::Clear()
+{
+	m_Outputs.clear();
+	m_AnyOutput.clear();
+}
+
+void CEntityOutputRegistry::SetFunction(object oFunction)
+{
+	if (m_bHooked)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "The function has already been hooked.")
+
+	if (!oFunction.is_none() && !extract<CFunction*>(oFunction).check())
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "The function must be a Function instance.")
+
+	m_oFunction = oFunction;
+
+	// Callbacks might have been registered before the function was known
+	if (GetCount())
+		Hook();
+}
+
+void CEntityOutputRegistry::Hook()
+{
+	// FireOutput couldn't be found. A warning has already been printed.
+	if (m_bHooked || m_oFunction.is_none())
+		return;
+
+	CFunction* pFunc = extract<CFunction*>(m_oFunction);
+	if (!pFunc->AddHook(HOOKTYPE_PRE, (HookHandlerFn*) (void*) &PreFireOutput))
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Could not create a hook for CBaseEntityOutput::FireOutput.")
+
+	m_bHooked = true;
+}
+
+EntityOutputCallbackList& CEntityOutputRegistry::GetCallbacks(object oOutput)
+{
+	if (oOutput.is_none())
+		return m_AnyOutput;
+
+	return m_Outputs[ToLower(extract<const char*>(oOutput))];
+}
+
+void CEntityOutputRegistry::CollectCallbacks(EntityOutputCallbackList& callbacks, CBaseEntity* pCaller,
+	char* szTargetName, bool& bTargetNameRetrieved, std::list<object>& result)
+{
+	for (EntityOutputCallbackList::iterator it=callbacks.begin(); it != callbacks.end(); ++it)
+	{
+		if (!it->m_Classname.empty())
+		{
+			const char* szClassname = IServerUnknownExt::GetClassname((IServerUnknown *) pCaller);
+			if (!szClassname || it->m_Classname != szClassname)
+				continue;
+		}
+
+		if (!it->m_TargetName.empty())
+		{
+			// Only retrieve the target name if it's required
+			if (!bTargetNameRetrieved)
+			{
+				((CBaseEntityWrapper *) pCaller)->GetKeyValueStringRaw("targetname", szTargetName, MAX_KEY_VALUE_LENGTH);
+				bTargetNameRetrieved = true;
+			}
+
+			if (V_stricmp(it->m_TargetName.c_str(), szTargetName) != 0)
+				continue;
+		}
+
+		result.push_back(it->m_oCallback);
+	}
+}
+
+bool CEntityOutputRegistry::Dispatch(CHook* pHook)
+{
+	if (GetHooksDisabled() || m_oDispatcher.is_none())
+		return false;
+
+	if (m_Outputs.empty() && m_AnyOutput.empty())
+		return false;
+
+	// Without the caller, the output name can't be retrieved
+	CBaseEntity* pCaller = pHook->GetArgument<CBaseEntity*>(3 + FIRE_OUTPUT_ARGUMENT_OFFSET);
+	if (!pCaller)
+		return false;
+
+	const char* szOutput = FindOutputName(pCaller, pHook->GetArgument<void*>(0));
+	if (!szOutput)
+		return false;
+
+	EntityOutputMap::iterator it = m_Outputs.find(ToLower(szOutput));
+	if (it == m_Outputs.end() && m_AnyOutput.empty())
+		return false;
+
+	// Copy the matching callbacks, so they can unregister themselves
+	std::list<object> callbacks;
+	char szTargetName[MAX_KEY_VALUE_LENGTH];
+	bool bTargetNameRetrieved = false;
+	if (it != m_Outputs.end())
+		CollectCallbacks(it->second, pCaller, szTargetName, bTargetNameRetrieved, callbacks);
+
+	CollectCallbacks(m_AnyOutput, pCaller, szTargetName, bTargetNameRetrieved, callbacks);
+	if (callbacks.empty())
+		return false;
+
+	BEGIN_BOOST_PY()
+		list oCallbacks;
+		for (std::list<object>::iterator callback=callbacks.begin(); callback != callbacks.end(); ++callback)
+			oCallbacks.append(*callback);
+
+		object result = m_oDispatcher(
+			oCallbacks,
+			szOutput,
+			CPointer(pHook->GetArgument<unsigned long>(2 + FIRE_OUTPUT_ARGUMENT_OFFSET)),
+			CPointer((unsigned long) pCaller),
+			CPointer(pHook->GetArgument<unsigned long>(1 + FIRE_OUTPUT_ARGUMENT_OFFSET)),
+			pHook->GetArgument<float>(4 + FIRE_OUTPUT_ARGUMENT_OFFSET));
+
+		// Skip the original function, if the output has been blocked
+		return extract<bool>(result);
+	END_BOOST_PY_NORET()
+
+	return false;
+}
@@ -0,0 +1,126 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+#ifndef _ENTITIES_OUTPUTS_H
+#define _ENTITIES_OUTPUTS_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+// C++
+#include <list>
+#include <string>
+
+// Boost
+#include "boost/unordered_map.hpp"
+
+// Source.Python
+#include "entities_entity.h"
+#include "modules/memory/memory_hooks.h"
+
+
+//-----------------------------------------------------------------------------
+// Constants.
+//-----------------------------------------------------------------------------
+// On Windows, variant_t is passed by value to CBaseEntityOutput::FireOutput,
+// which moves the other arguments by 4 slots
+#ifdef _WIN32
+	#define FIRE_OUTPUT_ARGUMENT_OFFSET 4
+#else
+	#define FIRE_OUTPUT_ARGUMENT_OFFSET 0
+#endif
+
+
+//-----------------------------------------------------------------------------
+// A registered output callback.
+//-----------------------------------------------------------------------------
+struct EntityOutputCallback_t
+{
+	object		m_oCallback;
+
+	// Empty strings match every entity
+	std::string	m_Classname;
+	std::string	m_TargetName;
+};
+
+typedef std::list<EntityOutputCallback_t> EntityOutputCallbackList;
+
+// Lower case output names -> callbacks
+typedef boost::unordered_map<std::string, EntityOutputCallbackList> EntityOutputMap;
+
+
+//-----------------------------------------------------------------------------
+// Calls Python callbacks for registered outputs.
+//
+// A single pre-hook on CBaseEntityOutput::FireOutput looks up the output
+// name and the caller natively. Python is only entered if a callback has
+// been registered for the fired output and the caller.
+//-----------------------------------------------------------------------------
+class CEntityOutputRegistry
+{
+public:
+	CEntityOutputRegistry();
+
+	void Register(object oCallback, object oOutput, object oClassname, object oTargetName);
+	void Unregister(object oCallback, object oOutput, object oClassname, object oTargetName);
+	bool IsRegistered(const char* szOutput);
+	int GetCount();
+	void Clear();
+
+	object GetFunction() { return m_oFunction; }
+	void SetFunction(object oFunction);
+
+	object GetDispatcher() { return m_oDispatcher; }
+	void SetDispatcher(object oDispatcher) { m_oDispatcher = oDispatcher; }
+
+	bool Dispatch(CHook* pHook);
+
+private:
+	void Hook();
+	EntityOutputCallbackList& GetCallbacks(object oOutput);
+	void CollectCallbacks(EntityOutputCallbackList& callbacks, CBaseEntity* pCaller,
+		char* szTargetName, bool& bTargetNameRetrieved, std::list<object>& result);
+
+private:
+	EntityOutputMap				m_Outputs;
+
+	// Callbacks that are called for every output
+	EntityOutputCallbackList	m_AnyOutput;
+
+	// CFunction instance of CBaseEntityOutput::FireOutput
+	object						m_oFunction;
+
+	// Python function that converts the arguments and calls the callbacks
+	object						m_oDispatcher;
+
+	bool						m_bHooked;
+};
+
+extern CEntityOutputRegistry g_EntityOutputRegistry;
+
+
+#endif // _ENTITIES_OUTPUTS_H
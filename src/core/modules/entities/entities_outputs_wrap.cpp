@@ -0,0 +1,104 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2019 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "export_main.h"
+#include "utilities/wrap_macros.h"
+#include "entities_outputs.h"
+
+
+//-----------------------------------------------------------------------------
+// Forward declarations.
+//-----------------------------------------------------------------------------
+void export_entity_output_registry(scope);
+
+
+//-----------------------------------------------------------------------------
+// Declare the _entities._outputs module.
+//-----------------------------------------------------------------------------
+DECLARE_SP_SUBMODULE(_entities, _outputs)
+{
+	export_entity_output_registry(_outputs);
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports CEntityOutputRegistry.
+//-----------------------------------------------------------------------------
+void export_entity_output_registry(scope _outputs)
+{
+	class_<CEntityOutputRegistry, boost::noncopyable> EntityOutputRegistry("EntityOutputRegistry", no_init);
+
+	EntityOutputRegistry.def("register",
+		&CEntityOutputRegistry::Register,
+		"Register a callback for an output.\n\n"
+		":param callable callback: The callback to register.\n"
+		":param str output_name: Name of the output. If None, the callback is called for every output.\n"
+		":param str classname: If given, only outputs of entities with this classname are passed.\n"
+		":param str target_name: If given, only outputs of entities with this target name are passed.",
+		(arg("callback"), arg("output_name")=object(), arg("classname")=object(), arg("target_name")=object())
+	);
+
+	EntityOutputRegistry.def("unregister",
+		&CEntityOutputRegistry::Unregister,
+		"Unregister a callback. The arguments must equal the ones passed to :meth:`register`.",
+		(arg("callback"), arg("output_name")=object(), arg("classname")=object(), arg("target_name")=object())
+	);
+
+	EntityOutputRegistry.def("is_registered",
+		&CEntityOutputRegistry::IsRegistered,
+		"Return True if a callback might be called for the given output.",
+		args("output_name")
+	);
+
+	EntityOutputRegistry.def("clear",
+		&CEntityOutputRegistry::Clear,
+		"Unregister all callbacks."
+	);
+
+	EntityOutputRegistry.def("__len__",
+		&CEntityOutputRegistry::GetCount,
+		"Return the number of registered callbacks."
+	);
+
+	EntityOutputRegistry.add_property("function",
+		&CEntityOutputRegistry::GetFunction,
+		&CEntityOutputRegistry::SetFunction,
+		"The Function instance of CBaseEntityOutput::FireOutput that is hooked."
+	);
+
+	EntityOutputRegistry.add_property("dispatcher",
+		&CEntityOutputRegistry::GetDispatcher,
+		&CEntityOutputRegistry::SetDispatcher,
+		"A callable that receives the matching callbacks, the output name, and pointers to the "
+		"activator, the caller and the value, and the delay. It must return True to block the output."
+	);
+
+	_outputs.attr("entity_output_registry") = object(ptr(&g_EntityOutputRegistry));
+}
@@ -33,6 +33,7 @@
 #include "igameevents.h"
 #include "modules/keyvalues/keyvalues.h"
 #include "events_generator.h"
+#include "modules/core/core_profiler.h"
 
 
 //-----------------------------------------------------------------------------
@@ -125,6 +126,7 @@ class CGameEventListener2: public IGameEventListener2, public wrapper<IGameEvent
 public:
 	virtual void FireGameEvent(IGameEvent* pEvent)
 	{
+		CFrameBudgetScope frame_scope(FRAME_SUBSYSTEM_EVENTS);
 		BEGIN_BOOST_PY()
 			get_override("fire_game_event")(ptr(pEvent));
 		END_BOOST_PY()
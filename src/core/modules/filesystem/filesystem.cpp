@@ -27,6 +27,10 @@
 //---------------------------------------------------------------------------------
 // Includes.
 //---------------------------------------------------------------------------------
+// C++
+#include <cstring>
+#include <string>
+
 // Source.Python
 #include "modules/memory/memory_alloc.h"
 #include "utilities/wrap_macros.h"
@@ -38,8 +42,6 @@
 //---------------------------------------------------------------------------------
 extern IFileSystem* filesystem;
 
-// Chunk size for InternalReadline()
-#define CHUNK_SIZE 128
 
 
 //---------------------------------------------------------------------------------
@@ -55,37 +57,53 @@ bool IsVPKFile(const char* file_path)
 //---------------------------------------------------------------------------------
 // SourceFile - constructor/destructor
 //---------------------------------------------------------------------------------
-SourceFile::SourceFile(FileHandle_t handle)
+SourceFile::SourceFile(FileHandle_t handle, int buffer_size)
 {
 	if (handle == FILESYSTEM_INVALID_HANDLE)
 		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Handle is invalid.")
 
 	m_handle = handle;
 	m_mode = NULL;
+	m_buffer = NULL;
+	m_bufferPos = 0;
+	m_bufferEnd = 0;
+	m_content = NULL;
+	SetBufferSize(buffer_size);
 }
 
-SourceFile::SourceFile(FileHandle_t handle, const char* mode)
+SourceFile::SourceFile(FileHandle_t handle, const char* mode, int buffer_size)
 {
 	if (handle == FILESYSTEM_INVALID_HANDLE)
 		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Handle is invalid.")
 
 	m_handle = handle;
 	m_mode = strdup(mode);
+	m_buffer = NULL;
+	m_bufferPos = 0;
+	m_bufferEnd = 0;
+	m_content = NULL;
+	SetBufferSize(buffer_size);
 }
 
 SourceFile::~SourceFile()
 {
 	if (m_mode)
 		free(m_mode);
+
+	delete[] m_buffer;
+	Py_XDECREF(m_content);
 }
 
-SourceFile* SourceFile::Open(const char* pFileName, const char* pMode, const char* pathID)
+SourceFile* SourceFile::Open(const char* pFileName, const char* pMode, const char* pathID, int buffer_size)
 {
+	if (buffer_size < 1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Buffer size must be greater than 0.")
+
 	FileHandle_t handle = filesystem->Open(pFileName, pMode, pathID);
 	if (handle == FILESYSTEM_INVALID_HANDLE)
 		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Unable to open file: %s", pFileName)
 
-	return new SourceFile(handle, pMode);
+	return new SourceFile(handle, pMode, buffer_size);
 }
 
 
@@ -101,10 +119,24 @@ PyObject* SourceFile::Read(int size)
 	}
 
 	char* pOutput = new char[size+1];
-	int bytesRead = filesystem->Read(pOutput, size, m_handle);
+	int bytesRead = ReadBuffered(pOutput, size);
 	return ConsumeBuffer(pOutput, bytesRead);
 }
 
+int SourceFile::ReadInto(object buffer)
+{
+	CheckClosed();
+	CheckReadable();
+
+	Py_buffer view;
+	if (PyObject_GetBuffer(buffer.ptr(), &view, PyBUF_WRITABLE) != 0)
+		throw_error_already_set();
+
+	int bytesRead = ReadBuffered((char*) view.buf, (int) view.len);
+	PyBuffer_Release(&view);
+	return bytesRead;
+}
+
 PyObject* SourceFile::Readline(int size)
 {
 	CheckClosed();
@@ -116,52 +148,54 @@ PyObject* SourceFile::Readline(int size)
 
 PyObject* SourceFile::InternalReadline(bool binaryMode, int size, int& outBytesRead)
 {
-	int bytesPut = 0;
-	char* buffer = (char*) UTIL_Alloc(CHUNK_SIZE);
-
-	while (size < 0 || bytesPut < size) {
-		char temp[1];
+	std::string line;
 
+	while (size < 0 || (int) line.size() < size) {
 		// EOF?
-		if (filesystem->Read(temp, 1, m_handle) != 1) {
+		if (m_bufferPos == m_bufferEnd && FillBuffer() == 0) {
 			break;
 		}
 
-		// Ignore \r in text mode
-		if (!binaryMode && temp[0] == '\r') {
-			continue;
+		const char* start = m_buffer + m_bufferPos;
+		int available = m_bufferEnd - m_bufferPos;
+		if (size >= 0 && available > size - (int) line.size()) {
+			available = size - (int) line.size();
 		}
-		
-		if (temp[0] == '\0') {
-			buffer[bytesPut] = '\n';
+
+		const char* end = (const char*) memchr(start, '\n', available);
+		int count = end ? (int) (end - start) + 1 : available;
+		m_bufferPos += count;
+
+		// Ignore \r in text mode and replace \0 with \n
+		bool ignoreCR = !binaryMode && memchr(start, '\r', count);
+		if (!ignoreCR && !memchr(start, '\0', count)) {
+			line.append(start, count);
 		}
 		else {
-			buffer[bytesPut] = temp[0];
-		}
-		++bytesPut;
-		++outBytesRead;
+			for (int i=0; i < count; ++i) {
+				if (ignoreCR && start[i] == '\r') {
+					continue;
+				}
 
-		if (temp[0] == '\n') {
-			break;
+				line.push_back(start[i] == '\0' ? '\n' : start[i]);
+			}
 		}
 
-		if (bytesPut >= CHUNK_SIZE) {
-			buffer = (char*) UTIL_Realloc(buffer, bytesPut + CHUNK_SIZE);
-			if (buffer == NULL)
-				BOOST_RAISE_EXCEPTION(PyExc_MemoryError, "Failed to reallocate the buffer.")
+		if (end) {
+			break;
 		}
 	}
-	
+
+	outBytesRead += (int) line.size();
+
 	PyObject* result = NULL;
 	if (IsBinaryMode()) {
-		result = PyBytes_FromStringAndSize(buffer, bytesPut);
+		result = PyBytes_FromStringAndSize(line.data(), line.size());
 	}
 	else {
-		result = PyUnicode_FromStringAndSize(buffer, bytesPut);
+		result = PyUnicode_FromStringAndSize(line.data(), line.size());
 	}
 
-	UTIL_Dealloc(buffer);
-
 	return result;
 }
 
@@ -201,6 +235,76 @@ PyObject* SourceFile::ConsumeBuffer(char* buffer, int bytesRead)
 	return result;
 }
 
+// internal
+int SourceFile::FillBuffer()
+{
+	if (!m_buffer) {
+		m_buffer = new char[m_bufferSize];
+	}
+
+	m_bufferPos = 0;
+	m_bufferEnd = filesystem->Read(m_buffer, m_bufferSize, m_handle);
+	if (m_bufferEnd < 0) {
+		m_bufferEnd = 0;
+	}
+
+	return m_bufferEnd;
+}
+
+// internal
+int SourceFile::ReadBuffered(char* pOutput, int size)
+{
+	// Consume the buffered data first
+	int bytesRead = GetBufferedBytes();
+	if (bytesRead > size) {
+		bytesRead = size;
+	}
+
+	if (bytesRead > 0) {
+		memcpy(pOutput, m_buffer + m_bufferPos, bytesRead);
+		m_bufferPos += bytesRead;
+		size -= bytesRead;
+	}
+
+	if (size <= 0) {
+		return bytesRead;
+	}
+
+	// Large reads don't need to go through the buffer
+	if (size >= m_bufferSize) {
+		int result = filesystem->Read(pOutput + bytesRead, size, m_handle);
+		return result > 0 ? bytesRead + result : bytesRead;
+	}
+
+	int count = FillBuffer();
+	if (count > size) {
+		count = size;
+	}
+
+	memcpy(pOutput + bytesRead, m_buffer, count);
+	m_bufferPos = count;
+	return bytesRead + count;
+}
+
+// internal
+void SourceFile::DiscardBuffer()
+{
+	// Move the file position back to the first byte that hasn't been consumed
+	int unconsumed = GetBufferedBytes();
+	if (unconsumed > 0) {
+		filesystem->Seek(m_handle, -unconsumed, FILESYSTEM_SEEK_CURRENT);
+	}
+
+	m_bufferPos = 0;
+	m_bufferEnd = 0;
+}
+
+// internal
+int SourceFile::GetBufferedBytes()
+{
+	return m_bufferEnd - m_bufferPos;
+}
+
 
 //---------------------------------------------------------------------------------
 // SourceFile - writing
@@ -209,6 +313,7 @@ void SourceFile::Write(PyObject* data)
 {
 	CheckClosed();
 	CheckWriteable();
+	DiscardBuffer();
 
 	WriteData(data);
 }
@@ -217,6 +322,7 @@ void SourceFile::Writelines(list lines)
 {
 	CheckClosed();
 	CheckWriteable();
+	DiscardBuffer();
 
 	for (int i=0; i < len(lines); ++i) {
 		object data = lines[i];
@@ -271,6 +377,7 @@ void SourceFile::Save(const char* file_path)
 	if (handle == FILESYSTEM_INVALID_HANDLE)
 		BOOST_RAISE_EXCEPTION(PyExc_IOError, "Failed to open file: %s", file_path)
 
+	DiscardBuffer();
 	int size = Size();
 	void* buffer = new char[size+1];
 	int bytesRead = filesystem->Read(buffer, size, m_handle);
@@ -287,18 +394,27 @@ void SourceFile::Close()
 		filesystem->Close(m_handle);
 		m_handle = NULL;
 	}
+
+	delete[] m_buffer;
+	m_buffer = NULL;
+	m_bufferPos = 0;
+	m_bufferEnd = 0;
+
+	Py_XDECREF(m_content);
+	m_content = NULL;
 }
 
 void SourceFile::Seek(int pos, int seekType)
 {
 	CheckClosed();
+	DiscardBuffer();
 	filesystem->Seek(m_handle, pos, (FileSystemSeek_t) seekType);
 }
 
 unsigned int SourceFile::Tell()
 {
 	CheckClosed();
-	return filesystem->Tell(m_handle);
+	return filesystem->Tell(m_handle) - GetBufferedBytes();
 }
 
 unsigned int SourceFile::Size()
@@ -310,6 +426,7 @@ unsigned int SourceFile::Size()
 void SourceFile::Flush()
 {
 	CheckClosed();
+	DiscardBuffer();
 	filesystem->Flush(m_handle);
 }
 
@@ -344,7 +461,56 @@ bool SourceFile::Closed()
 
 bool SourceFile::EndOfFile()
 {
-	return filesystem->EndOfFile(m_handle);
+	return GetBufferedBytes() == 0 && filesystem->EndOfFile(m_handle);
+}
+
+PyObject* SourceFile::GetView()
+{
+	CheckClosed();
+	CheckReadable();
+	if (Writeable())
+		BOOST_RAISE_EXCEPTION(PyExc_IOError, "Views are only available for read-only files.")
+
+	// Read the whole file once. All views share the same content.
+	if (!m_content) {
+		unsigned int pos = Tell();
+		DiscardBuffer();
+
+		int size = filesystem->Size(m_handle);
+		PyObject* content = PyBytes_FromStringAndSize(NULL, size);
+		if (!content)
+			throw_error_already_set();
+
+		filesystem->Seek(m_handle, 0, FILESYSTEM_SEEK_HEAD);
+		int bytesRead = filesystem->Read(PyBytes_AS_STRING(content), size, m_handle);
+		filesystem->Seek(m_handle, pos, FILESYSTEM_SEEK_HEAD);
+
+		if (bytesRead < size && _PyBytes_Resize(&content, bytesRead > 0 ? bytesRead : 0) != 0)
+			throw_error_already_set();
+
+		m_content = content;
+	}
+
+	return PyMemoryView_FromObject(m_content);
+}
+
+int SourceFile::GetBufferSize()
+{
+	return m_bufferSize;
+}
+
+void SourceFile::SetBufferSize(int size)
+{
+	if (size < 1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Buffer size must be greater than 0.")
+
+	if (m_handle != FILESYSTEM_INVALID_HANDLE) {
+		DiscardBuffer();
+	}
+
+	delete[] m_buffer;
+	m_buffer = NULL;
+	m_bufferSize = size;
 }
 
 
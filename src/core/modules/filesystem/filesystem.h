@@ -33,18 +33,26 @@
 #include "public/filesystem.h"
 
 
+//---------------------------------------------------------------------------------
+// Constants.
+//---------------------------------------------------------------------------------
+// Default size of the read-ahead buffer of SourceFile
+#define DEFAULT_READ_BUFFER_SIZE 8192
+
+
 //---------------------------------------------------------------------------------
 // SourceFile class.
 //---------------------------------------------------------------------------------
 class SourceFile
 {
 public:
-	SourceFile(FileHandle_t handle);
-	SourceFile(FileHandle_t handle, const char* mode);
+	SourceFile(FileHandle_t handle, int buffer_size=DEFAULT_READ_BUFFER_SIZE);
+	SourceFile(FileHandle_t handle, const char* mode, int buffer_size=DEFAULT_READ_BUFFER_SIZE);
 	~SourceFile();
 
 	// File-like methods
 	PyObject*		Read(int size=-1);
+	int				ReadInto(object buffer);
 	void			Write(PyObject* data);
 	void			Close();
 	void			Seek(int pos, int seekType=FILESYSTEM_SEEK_HEAD);
@@ -74,8 +82,12 @@ public:
 	// void			Delete();
 	// void			Rename();
 	bool			EndOfFile();
+	PyObject*		GetView();
 
-	static SourceFile* Open(const char* pFileName, const char* pMode, const char* pathID=0);
+	int				GetBufferSize();
+	void			SetBufferSize(int size);
+
+	static SourceFile* Open(const char* pFileName, const char* pMode, const char* pathID=0, int buffer_size=DEFAULT_READ_BUFFER_SIZE);
 
 private:
 	PyObject*		ConsumeBuffer(char* buffer, int bytesRead);
@@ -86,9 +98,24 @@ private:
 	void			CheckWriteable();
 	PyObject*		InternalReadline(bool binaryMode, int size, int& outBytesRead);
 
+	// Read-ahead buffer
+	int				FillBuffer();
+	int				ReadBuffered(char* pOutput, int size);
+	void			DiscardBuffer();
+	int				GetBufferedBytes();
+
 private:
 	FileHandle_t m_handle;
 	char* m_mode;
+
+	// Data that has been read from the file, but not consumed yet.
+	char* m_buffer;
+	int m_bufferSize;
+	int m_bufferPos;
+	int m_bufferEnd;
+
+	// Content returned by GetView().
+	PyObject* m_content;
 };
 
 
@@ -64,7 +64,7 @@ void export_functions(scope _filesystem)
 //-----------------------------------------------------------------------------
 void export_source_file(scope _filesystem)
 {
-	class_<SourceFile> _SourceFile("SourceFile", init<FileHandle_t>());
+	class_<SourceFile, boost::noncopyable> _SourceFile("SourceFile", init<FileHandle_t, optional<int> >());
 
 	// File-like methods
 	_SourceFile.def(
@@ -79,6 +79,15 @@ void export_source_file(scope _filesystem)
 		(arg("size")=-1)
 	);
 
+	_SourceFile.def(
+		"readinto",
+		&SourceFile::ReadInto,
+		(arg("buffer")),
+		"Read bytes into a pre-allocated, writable bytes-like object.\n\n"
+		":return: The number of bytes that have been read.\n"
+		":rtype: int"
+	);
+
 	_SourceFile.def(
 		"readline",
 		&SourceFile::Readline,
@@ -173,11 +182,29 @@ void export_source_file(scope _filesystem)
 		"eof",
 		&SourceFile::EndOfFile
 	);
+
+	_SourceFile.add_property(
+		"buffer_size",
+		&SourceFile::GetBufferSize,
+		&SourceFile::SetBufferSize,
+		"Return or set the size of the read-ahead buffer in bytes.\n\n"
+		":rtype: int"
+	);
+
+	_SourceFile.def(
+		"get_view",
+		&SourceFile::GetView,
+		"Return a read-only memoryview of the whole file.\n\n"
+		"The file is read once and all views share its content, so slicing them doesn't copy any data. "
+		"This is useful for files that are stored in VPKs and can't be accessed by Python's file functions. "
+		"Only available for files that have been opened read-only.\n\n"
+		":rtype: memoryview"
+	);
 	
 	_SourceFile.def(
 		"open",
 		&SourceFile::Open,
-		(arg("file_path"), arg("mode")="rt", arg("path_id")=object()),
+		(arg("file_path"), arg("mode")="rt", arg("path_id")=object(), arg("buffer_size")=DEFAULT_READ_BUFFER_SIZE),
 		manage_new_object_policy()
 	).staticmethod("open");
 }
@@ -58,6 +58,63 @@ extern IServerPluginHelpers	*helpers;
 extern CGlobalVars *gpGlobals;
 
 
+//---------------------------------------------------------------------------------
+// Player masks.
+//---------------------------------------------------------------------------------
+// The connected players are cached for a single tick. Alive and team states
+// can change at any time (e.g. by a death in the same tick), so they are read
+// whenever they are used.
+struct CPlayerMasks
+{
+	CPlayerMasks()
+	{
+		m_iConnectedTick = -1;
+		m_iDisconnectingTick = -1;
+	}
+
+	int m_iConnectedTick;
+	float m_flConnectedTime;
+	CRecipientBits m_Connected;
+
+	int m_iDisconnectingTick;
+	CRecipientBits m_Disconnecting;
+};
+
+static CPlayerMasks s_PlayerMasks;
+
+// Returns true if the mask with the given time stamp was created this tick
+static bool IsCurrentTick(int iTick, float flTime)
+{
+	return iTick == gpGlobals->tickcount && flTime == gpGlobals->realtime;
+}
+
+// Sets the bits of all players in the given set that are alive
+static void GetAlivePlayers(const CRecipientBits& players, CRecipientBits& result)
+{
+	result.ClearAll();
+	for (int iPlayer = players.FindNextSetBit(0); iPlayer != -1; iPlayer = players.FindNextSetBit(iPlayer + 1))
+	{
+		IPlayerInfo* pInfo;
+		if (PlayerInfoFromIndex(iPlayer, pInfo) && !pInfo->IsDead())
+			result.Set(iPlayer);
+	}
+}
+
+// Sets the bits of all connected players in the given team
+static void GetTeamPlayers(int iTeam, CRecipientBits& result)
+{
+	result.ClearAll();
+
+	const CRecipientBits& connected = MRecipientFilter::GetConnectedPlayers();
+	for (int iPlayer = connected.FindNextSetBit(0); iPlayer != -1; iPlayer = connected.FindNextSetBit(iPlayer + 1))
+	{
+		IPlayerInfo* pInfo;
+		if (PlayerInfoFromIndex(iPlayer, pInfo) && pInfo->GetTeamIndex() == iTeam)
+			result.Set(iPlayer);
+	}
+}
+
+
 //---------------------------------------------------------------------------------
 // MRecipientFilter methods.
 //---------------------------------------------------------------------------------
@@ -96,25 +153,40 @@ int MRecipientFilter::GetRecipientIndex(int slot) const
 	return m_Recipients[slot];
 }
 
-void MRecipientFilter::AddAllPlayers()
+void MRecipientFilter::SetBits(const CRecipientBits& bits)
 {
-	m_Recipients.RemoveAll();
-
-	for(int i = 1; i <= gpGlobals->maxClients; i++)
+	// Remove the players that are not set anymore, but keep the order of
+	// the remaining ones
+	for (int i = m_Recipients.Count() - 1; i >= 0; i--)
 	{
-		// Make sure the player is valid
-		edict_t* pPlayer;
-		if(!EdictFromIndex(i, pPlayer))
-			continue;
-
-		m_Recipients.AddToTail(i);
+		if (!bits.IsBitSet(m_Recipients[i]))
+			m_Recipients.Remove(i);
 	}
+
+	// New players are added in ascending order
+	CRecipientBits added = bits;
+	added.AndNot(m_Bits);
+	for (int iPlayer = added.FindNextSetBit(0); iPlayer != -1; iPlayer = added.FindNextSetBit(iPlayer + 1))
+		m_Recipients.AddToTail(iPlayer);
+
+	m_Bits = bits;
+}
+
+void MRecipientFilter::AddAllPlayers()
+{
+	m_Recipients.RemoveAll();
+	m_Bits.ClearAll();
+	SetBits(GetConnectedPlayers());
 }
 
 void MRecipientFilter::AddRecipient(int iPlayer)
 {
-	// Return if the recipient is already in the vector
-	if(m_Recipients.Find(iPlayer) != m_Recipients.InvalidIndex())
+	// Skip non-player entities.
+	if (iPlayer <= WORLD_ENTITY_INDEX || iPlayer > gpGlobals->maxClients)
+		return;
+
+	// Return if the recipient is already in the filter
+	if (m_Bits.IsBitSet(iPlayer))
 		return;
 
 	// Make sure the player is valid
@@ -122,22 +194,154 @@ void MRecipientFilter::AddRecipient(int iPlayer)
 	if(!EdictFromIndex(iPlayer, pPlayer))
 		return;
 
-	// Skip non-player entities.
-	if (iPlayer > WORLD_ENTITY_INDEX && iPlayer <= gpGlobals->maxClients)
-		m_Recipients.AddToTail(iPlayer);
+	m_Bits.Set(iPlayer);
+	m_Recipients.AddToTail(iPlayer);
 }
 
 void MRecipientFilter::RemoveRecipient( int iPlayer )
 {
+	if (!HasRecipient(iPlayer))
+		return;
+
+	m_Bits.Clear(iPlayer);
 	m_Recipients.FindAndRemove(iPlayer);
 }
 
 void MRecipientFilter::RemoveAllPlayers()
 {
+	m_Bits.ClearAll();
 	m_Recipients.RemoveAll();
 }
 
 bool MRecipientFilter::HasRecipient( int iPlayer )
 {
-	return m_Recipients.HasElement(iPlayer);
+	return CRecipientBits::IsValidBit(iPlayer) && m_Bits.IsBitSet(iPlayer);
+}
+
+void MRecipientFilter::Union(MRecipientFilter& other)
+{
+	// Players of the other filter are added in its order
+	for (int i = 0; i < other.m_Recipients.Count(); i++)
+	{
+		int iPlayer = other.m_Recipients[i];
+		if (m_Bits.IsBitSet(iPlayer))
+			continue;
+
+		m_Bits.Set(iPlayer);
+		m_Recipients.AddToTail(iPlayer);
+	}
+}
+
+void MRecipientFilter::Intersect(MRecipientFilter& other)
+{
+	CRecipientBits bits = m_Bits;
+	bits.And(other.m_Bits);
+	SetBits(bits);
+}
+
+void MRecipientFilter::Difference(MRecipientFilter& other)
+{
+	CRecipientBits bits = m_Bits;
+	bits.AndNot(other.m_Bits);
+	SetBits(bits);
+}
+
+void MRecipientFilter::AddTeam(int iTeam)
+{
+	CRecipientBits bits;
+	GetTeamPlayers(iTeam, bits);
+	bits.Or(m_Bits);
+	SetBits(bits);
+}
+
+void MRecipientFilter::RemoveTeam(int iTeam)
+{
+	CRecipientBits team;
+	GetTeamPlayers(iTeam, team);
+
+	CRecipientBits bits = m_Bits;
+	bits.AndNot(team);
+	SetBits(bits);
+}
+
+void MRecipientFilter::RemoveDeadPlayers()
+{
+	CRecipientBits alive;
+	GetAlivePlayers(m_Bits, alive);
+	SetBits(alive);
+}
+
+void MRecipientFilter::RemoveAlivePlayers()
+{
+	CRecipientBits alive;
+	GetAlivePlayers(m_Bits, alive);
+
+	CRecipientBits bits = m_Bits;
+	bits.AndNot(alive);
+	SetBits(bits);
+}
+
+object MRecipientFilter::__iter__(object self)
+{
+	return object(CRecipientFilterIter(self));
+}
+
+const CRecipientBits& MRecipientFilter::GetConnectedPlayers()
+{
+	if (IsCurrentTick(s_PlayerMasks.m_iConnectedTick, s_PlayerMasks.m_flConnectedTime))
+		return s_PlayerMasks.m_Connected;
+
+	s_PlayerMasks.m_Connected.ClearAll();
+	for(int i = 1; i <= gpGlobals->maxClients; i++)
+	{
+		// Make sure the player is valid
+		edict_t* pPlayer;
+		if(!EdictFromIndex(i, pPlayer))
+			continue;
+
+		s_PlayerMasks.m_Connected.Set(i);
+	}
+
+	// Players that are disconnecting might still be valid during this tick
+	if (s_PlayerMasks.m_iDisconnectingTick == gpGlobals->tickcount)
+		s_PlayerMasks.m_Connected.AndNot(s_PlayerMasks.m_Disconnecting);
+
+	s_PlayerMasks.m_iConnectedTick = gpGlobals->tickcount;
+	s_PlayerMasks.m_flConnectedTime = gpGlobals->realtime;
+	return s_PlayerMasks.m_Connected;
+}
+
+void MRecipientFilter::InvalidatePlayerMasks(int iDisconnectingPlayer)
+{
+	if (CRecipientBits::IsValidBit(iDisconnectingPlayer))
+	{
+		if (s_PlayerMasks.m_iDisconnectingTick != gpGlobals->tickcount)
+		{
+			s_PlayerMasks.m_Disconnecting.ClearAll();
+			s_PlayerMasks.m_iDisconnectingTick = gpGlobals->tickcount;
+		}
+
+		s_PlayerMasks.m_Disconnecting.Set(iDisconnectingPlayer);
+	}
+
+	s_PlayerMasks.m_iConnectedTick = -1;
+}
+
+
+//---------------------------------------------------------------------------------
+// CRecipientFilterIter methods.
+//---------------------------------------------------------------------------------
+CRecipientFilterIter::CRecipientFilterIter(object oFilter):
+	m_oFilter(oFilter)
+{
+	m_pFilter = extract<MRecipientFilter*>(oFilter);
+	m_iNext = 0;
+}
+
+int CRecipientFilterIter::__next__()
+{
+	if (m_iNext >= m_pFilter->m_Recipients.Count())
+		BOOST_RAISE_EXCEPTION(PyExc_StopIteration, "Iteration stops here.")
+
+	return m_pFilter->m_Recipients[m_iNext++];
 }
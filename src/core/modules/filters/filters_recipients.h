@@ -73,6 +73,81 @@ public:
 };
 
 
+//---------------------------------------------------------------------------------
+// A set of player indexes stored as bits.
+//---------------------------------------------------------------------------------
+#define RECIPIENT_BITS 256
+#define RECIPIENT_WORDS (RECIPIENT_BITS / 32)
+
+class CRecipientBits
+{
+public:
+	CRecipientBits()
+	{ ClearAll(); }
+
+	void ClearAll()
+	{ memset(m_Words, 0, sizeof(m_Words)); }
+
+	static bool IsValidBit(int iBit)
+	{ return iBit >= 0 && iBit < RECIPIENT_BITS; }
+
+	bool IsBitSet(int iBit) const
+	{ return (m_Words[iBit >> 5] & (1u << (iBit & 31))) != 0; }
+
+	void Set(int iBit)
+	{ m_Words[iBit >> 5] |= (1u << (iBit & 31)); }
+
+	void Clear(int iBit)
+	{ m_Words[iBit >> 5] &= ~(1u << (iBit & 31)); }
+
+	void Or(const CRecipientBits& other)
+	{
+		for (int i=0; i < RECIPIENT_WORDS; i++)
+			m_Words[i] |= other.m_Words[i];
+	}
+
+	void And(const CRecipientBits& other)
+	{
+		for (int i=0; i < RECIPIENT_WORDS; i++)
+			m_Words[i] &= other.m_Words[i];
+	}
+
+	void AndNot(const CRecipientBits& other)
+	{
+		for (int i=0; i < RECIPIENT_WORDS; i++)
+			m_Words[i] &= ~other.m_Words[i];
+	}
+
+	// Returns -1 if there is no set bit at or after the given bit
+	int FindNextSetBit(int iStartBit) const
+	{
+		for (int iBit = iStartBit; iBit < RECIPIENT_BITS; iBit++)
+		{
+			unsigned int uiWord = m_Words[iBit >> 5] >> (iBit & 31);
+			if (!uiWord)
+			{
+				// Skip the rest of the word
+				iBit |= 31;
+				continue;
+			}
+
+			while (!(uiWord & 1))
+			{
+				uiWord >>= 1;
+				iBit++;
+			}
+
+			return iBit;
+		}
+
+		return -1;
+	}
+
+public:
+	unsigned int m_Words[RECIPIENT_WORDS];
+};
+
+
 //---------------------------------------------------------------------------------
 // IRecipientFilter extension class
 //---------------------------------------------------------------------------------
@@ -108,6 +183,22 @@ public:
 	void RemoveAllPlayers();
 	bool HasRecipient(int iPlayer);
 
+	// Set operations
+	void Union(MRecipientFilter& other);
+	void Intersect(MRecipientFilter& other);
+	void Difference(MRecipientFilter& other);
+
+	void AddTeam(int iTeam);
+	void RemoveTeam(int iTeam);
+	void RemoveDeadPlayers();
+	void RemoveAlivePlayers();
+
+	static object __iter__(object self);
+
+	// Cached player masks
+	static const CRecipientBits& GetConnectedPlayers();
+	static void InvalidatePlayerMasks(int iDisconnectingPlayer=-1);
+
 	// Patch for issue #314.
 	static object from_abstract_pointer(object cls, object oPtr)
 	{
@@ -136,6 +227,36 @@ public:
 	// If ignoring prediction cull, then external systems can determine
 	//  whether this is a special case where culling should not occur
 	bool				m_bIgnorePredictionCull;
+
+	// The recipients as bits for fast lookups and set operations.
+	//  m_Recipients keeps the order they have been added in. It must be
+	//  added after all members the engine might expect.
+	CRecipientBits		m_Bits;
+
+private:
+	// Replaces the recipients with the given bits
+	void SetBits(const CRecipientBits& bits);
+};
+
+
+//---------------------------------------------------------------------------------
+// Iterates over the indexes of a recipient filter in the order they have been
+// added.
+//---------------------------------------------------------------------------------
+class CRecipientFilterIter
+{
+public:
+	CRecipientFilterIter(object oFilter);
+
+	static object __iter__(object self)
+	{ return self; }
+
+	int __next__();
+
+private:
+	object m_oFilter;
+	MRecipientFilter* m_pFilter;
+	int m_iNext;
 };
 
 
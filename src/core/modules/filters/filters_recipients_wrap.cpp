@@ -41,6 +41,7 @@
 //-----------------------------------------------------------------------------
 void export_irecipientfilter(scope);
 void export_mrecipientfilter(scope);
+void export_recipientfilter_iter(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -50,6 +51,19 @@ DECLARE_SP_SUBMODULE(_filters, _recipients)
 {
 	export_irecipientfilter(_recipients);
 	export_mrecipientfilter(_recipients);
+	export_recipientfilter_iter(_recipients);
+}
+
+
+//-----------------------------------------------------------------------------
+// Helper to expose in-place set operations that return the filter itself.
+//-----------------------------------------------------------------------------
+template<void (MRecipientFilter::*Operation)(MRecipientFilter&)>
+object InPlaceOperation(object self, MRecipientFilter& other)
+{
+	MRecipientFilter& filter = extract<MRecipientFilter&>(self);
+	(filter.*Operation)(other);
+	return self;
 }
 
 
@@ -121,6 +135,23 @@ void export_mrecipientfilter(scope _recipients)
 		args("index")
 	);
 
+	_RecipientFilter.def("__iter__",
+		&MRecipientFilter::__iter__,
+		"Return an iterator over all indexes in the order they have been added."
+	);
+
+	_RecipientFilter.def("__ior__",
+		&InPlaceOperation<&MRecipientFilter::Union>
+	);
+
+	_RecipientFilter.def("__iand__",
+		&InPlaceOperation<&MRecipientFilter::Intersect>
+	);
+
+	_RecipientFilter.def("__isub__",
+		&InPlaceOperation<&MRecipientFilter::Difference>
+	);
+
 	// Methods...
 	_RecipientFilter.def("add_all_players",
 		&MRecipientFilter::AddAllPlayers,
@@ -144,6 +175,46 @@ void export_mrecipientfilter(scope _recipients)
 		args("index")
 	);
 
+	_RecipientFilter.def("union_update",
+		&MRecipientFilter::Union,
+		"Add all players of the given recipient filter.",
+		args("other")
+	);
+
+	_RecipientFilter.def("intersection_update",
+		&MRecipientFilter::Intersect,
+		"Remove all players that are not in the given recipient filter.",
+		args("other")
+	);
+
+	_RecipientFilter.def("difference_update",
+		&MRecipientFilter::Difference,
+		"Remove all players of the given recipient filter.",
+		args("other")
+	);
+
+	_RecipientFilter.def("add_team",
+		&MRecipientFilter::AddTeam,
+		"Add all players of the given team.",
+		args("team_index")
+	);
+
+	_RecipientFilter.def("remove_team",
+		&MRecipientFilter::RemoveTeam,
+		"Remove all players of the given team.",
+		args("team_index")
+	);
+
+	_RecipientFilter.def("remove_dead_players",
+		&MRecipientFilter::RemoveDeadPlayers,
+		"Remove all players that are dead."
+	);
+
+	_RecipientFilter.def("remove_alive_players",
+		&MRecipientFilter::RemoveAlivePlayers,
+		"Remove all players that are alive."
+	);
+
 	_RecipientFilter.def_readwrite("reliable",
 		&MRecipientFilter::m_bReliable,
 		"Get/set whether or not the filter is reliable.\n\n"
@@ -153,3 +224,20 @@ void export_mrecipientfilter(scope _recipients)
 	// Add memory tools...
 	_RecipientFilter ADD_MEM_TOOLS(MRecipientFilter);
 }
+
+
+//-----------------------------------------------------------------------------
+// Exports CRecipientFilterIter
+//-----------------------------------------------------------------------------
+void export_recipientfilter_iter(scope _recipients)
+{
+	class_<CRecipientFilterIter> RecipientFilterIter("RecipientFilterIter", no_init);
+
+	RecipientFilterIter.def("__iter__",
+		&CRecipientFilterIter::__iter__
+	);
+
+	RecipientFilterIter.def("__next__",
+		&CRecipientFilterIter::__next__
+	);
+}
@@ -82,6 +82,7 @@ void CListenerManager::Notify(tuple args, dict kwargs)
 	for(int i = 0; i < m_vecCallables.Count(); i++)
 	{
 		BEGIN_BOOST_PY()
+			CCallbackProfileScope profile_scope(m_vecCallables[i].ptr(), FRAME_SUBSYSTEM_LISTENERS);
 			m_vecCallables[i](*args, **kwargs);
 		END_BOOST_PY_NORET()
 	}
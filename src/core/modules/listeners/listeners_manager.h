@@ -32,6 +32,7 @@
 //-----------------------------------------------------------------------------
 #include "utilities/wrap_macros.h"
 #include "utlvector.h"
+#include "modules/core/core_profiler.h"
 
 
 //-----------------------------------------------------------------------------
@@ -50,9 +51,15 @@
 	CALL_LISTENERS_WITH_MNGR(Get##name##ListenerManager(), __VA_ARGS__)
 
 #define CALL_LISTENERS_WITH_MNGR(mngr, ...) \
+	CALL_LISTENERS_WITH_SUBSYSTEM(mngr, FRAME_SUBSYSTEM_LISTENERS, __VA_ARGS__)
+
+// Calls all listeners of the given manager and accounts their time and calls
+// to the given FrameSubsystem_t
+#define CALL_LISTENERS_WITH_SUBSYSTEM(mngr, subsystem, ...) \
 	for(int i = 0; i < mngr->m_vecCallables.Count(); i++) \
 	{ \
 		BEGIN_BOOST_PY() \
+			CCallbackProfileScope profile_scope(mngr->m_vecCallables[i].ptr(), subsystem); \
 			mngr->m_vecCallables[i]( __VA_ARGS__ ); \
 		END_BOOST_PY_NORET() \
 	}
@@ -65,6 +72,7 @@
 	for(int i = 0; i < mngr->m_vecCallables.Count(); i++) \
 	{ \
 		BEGIN_BOOST_PY() \
+			CCallbackProfileScope profile_scope(mngr->m_vecCallables[i].ptr(), FRAME_SUBSYSTEM_LISTENERS); \
 			return_var = mngr->m_vecCallables[i]( __VA_ARGS__ ); \
 			action \
 		END_BOOST_PY_NORET() \
@@ -50,6 +50,7 @@ DEFINE_MANAGER_ACCESSOR(OnEdictFreed)
 DEFINE_MANAGER_ACCESSOR(OnQueryCvarValueFinished)
 DEFINE_MANAGER_ACCESSOR(OnServerActivate)
 DEFINE_MANAGER_ACCESSOR(OnTick)
+DEFINE_MANAGER_ACCESSOR(OnTickBudgetExceeded)
 DEFINE_MANAGER_ACCESSOR(OnEntityPreSpawned)
 DEFINE_MANAGER_ACCESSOR(OnNetworkedEntityPreSpawned)
 DEFINE_MANAGER_ACCESSOR(OnEntityCreated)
@@ -155,6 +156,7 @@ void export_listener_managers(scope _listeners)
 	_listeners.attr("on_server_activate_listener_manager") = object(ptr(GetOnServerActivateListenerManager()));
 
 	_listeners.attr("on_tick_listener_manager") = object(ptr(GetOnTickListenerManager()));
+	_listeners.attr("on_tick_budget_exceeded_listener_manager") = object(ptr(GetOnTickBudgetExceededListenerManager()));
 	
 	_listeners.attr("on_entity_pre_spawned_listener_manager") = object(ptr(GetOnEntityPreSpawnedListenerManager()));
 	_listeners.attr("on_networked_entity_pre_spawned_listener_manager") = object(ptr(GetOnNetworkedEntityPreSpawnedListenerManager()));
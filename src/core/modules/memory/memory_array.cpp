@@ -0,0 +1,268 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+// ============================================================================
+// >> INCLUDES
+// ============================================================================
+// Memory
+#include "memory_array.h"
+#include "memory_utilities.h"
+
+
+// ============================================================================
+// >> CArrayView
+// ============================================================================
+CArrayView::CArrayView(object oPtr, DataType_t eType, object oLength, int iStride)
+{
+	m_pBase = CPointer(ExtractAddress(oPtr));
+	m_eType = eType;
+
+	int iItemSize = GetItemSize(eType);
+	if (!iItemSize)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Unsupported array type: %i.", (int) eType)
+
+	m_iStride = iStride ? iStride : iItemSize;
+	if (m_iStride < iItemSize)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The stride (%i) is smaller than the item size (%i).", m_iStride, iItemSize)
+
+	m_iLength = oLength.is_none() ? -1 : extract<int>(oLength);
+	if (!oLength.is_none() && m_iLength < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid length: %i.", m_iLength)
+
+	m_shape = m_iLength;
+	m_strides = m_iStride;
+}
+
+int CArrayView::GetItemSize(DataType_t eType)
+{
+	switch(eType)
+	{
+		case DATA_TYPE_BOOL:		return sizeof(bool);
+		case DATA_TYPE_CHAR:		return sizeof(char);
+		case DATA_TYPE_UCHAR:		return sizeof(unsigned char);
+		case DATA_TYPE_SHORT:		return sizeof(short);
+		case DATA_TYPE_USHORT:		return sizeof(unsigned short);
+		case DATA_TYPE_INT:			return sizeof(int);
+		case DATA_TYPE_UINT:		return sizeof(unsigned int);
+		case DATA_TYPE_LONG:		return sizeof(long);
+		case DATA_TYPE_ULONG:		return sizeof(unsigned long);
+		case DATA_TYPE_LONG_LONG:	return sizeof(long long);
+		case DATA_TYPE_ULONG_LONG:	return sizeof(unsigned long long);
+		case DATA_TYPE_FLOAT:		return sizeof(float);
+		case DATA_TYPE_DOUBLE:		return sizeof(double);
+		case DATA_TYPE_POINTER:		return sizeof(void *);
+	}
+	return 0;
+}
+
+const char* CArrayView::GetFormat(DataType_t eType)
+{
+	// Only numeric types can be exported as a buffer
+	switch(eType)
+	{
+		case DATA_TYPE_BOOL:		return "?";
+		case DATA_TYPE_CHAR:		return "b";
+		case DATA_TYPE_UCHAR:		return "B";
+		case DATA_TYPE_SHORT:		return "h";
+		case DATA_TYPE_USHORT:		return "H";
+		case DATA_TYPE_INT:			return "i";
+		case DATA_TYPE_UINT:		return "I";
+		case DATA_TYPE_LONG:		return "l";
+		case DATA_TYPE_ULONG:		return "L";
+		case DATA_TYPE_LONG_LONG:	return "q";
+		case DATA_TYPE_ULONG_LONG:	return "Q";
+		case DATA_TYPE_FLOAT:		return "f";
+		case DATA_TYPE_DOUBLE:		return "d";
+	}
+	return NULL;
+}
+
+int CArrayView::__len__()
+{
+	if (m_iLength == -1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The length of the array is unknown.")
+
+	return m_iLength;
+}
+
+int CArrayView::ValidateIndex(int iIndex)
+{
+	if (m_iLength == -1)
+	{
+		if (iIndex < 0)
+			BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Negative indexes require the length of the array.")
+
+		return iIndex;
+	}
+
+	if (iIndex < 0)
+		iIndex += m_iLength;
+
+	if (iIndex < 0 || iIndex >= m_iLength)
+		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Index out of range.")
+
+	return iIndex;
+}
+
+object CArrayView::__getitem__(object oIndex)
+{
+	if (!PySlice_Check(oIndex.ptr()))
+		return GetItem(ValidateIndex(extract<int>(oIndex)));
+
+	if (m_iLength == -1)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Slicing requires the length of the array.")
+
+	Py_ssize_t start, stop, step, length;
+	if (PySlice_GetIndicesEx(oIndex.ptr(), m_iLength, &start, &stop, &step, &length) != 0)
+		throw_error_already_set();
+
+	list result;
+	for (Py_ssize_t i=0; i < length; ++i)
+		result.append(GetItem((int) (start + i * step)));
+
+	return result;
+}
+
+void CArrayView::__setitem__(int iIndex, object oValue)
+{
+	SetItem(ValidateIndex(iIndex), oValue);
+}
+
+list CArrayView::ToList()
+{
+	list result;
+	for (int i=0; i < __len__(); ++i)
+		result.append(GetItem(i));
+
+	return result;
+}
+
+CPointer* CArrayView::GetPointer()
+{
+	return new CPointer(m_pBase.m_ulAddr);
+}
+
+object CArrayView::GetLength()
+{
+	if (m_iLength == -1)
+		return object();
+
+	return object(m_iLength);
+}
+
+object CArrayView::GetItem(int iIndex)
+{
+	int iOffset = iIndex * m_iStride;
+	switch(m_eType)
+	{
+		case DATA_TYPE_BOOL:		return object(m_pBase.Get<bool>(iOffset));
+		case DATA_TYPE_CHAR:		return object(m_pBase.Get<char>(iOffset));
+		case DATA_TYPE_UCHAR:		return object(m_pBase.Get<unsigned char>(iOffset));
+		case DATA_TYPE_SHORT:		return object(m_pBase.Get<short>(iOffset));
+		case DATA_TYPE_USHORT:		return object(m_pBase.Get<unsigned short>(iOffset));
+		case DATA_TYPE_INT:			return object(m_pBase.Get<int>(iOffset));
+		case DATA_TYPE_UINT:		return object(m_pBase.Get<unsigned int>(iOffset));
+		case DATA_TYPE_LONG:		return object(m_pBase.Get<long>(iOffset));
+		case DATA_TYPE_ULONG:		return object(m_pBase.Get<unsigned long>(iOffset));
+		case DATA_TYPE_LONG_LONG:	return object(m_pBase.Get<long long>(iOffset));
+		case DATA_TYPE_ULONG_LONG:	return object(m_pBase.Get<unsigned long long>(iOffset));
+		case DATA_TYPE_FLOAT:		return object(m_pBase.Get<float>(iOffset));
+		case DATA_TYPE_DOUBLE:		return object(m_pBase.Get<double>(iOffset));
+		case DATA_TYPE_POINTER:		return object(CPointer(m_pBase.Get<unsigned long>(iOffset)));
+	}
+	return object();
+}
+
+void CArrayView::SetItem(int iIndex, object oValue)
+{
+	int iOffset = iIndex * m_iStride;
+	switch(m_eType)
+	{
+		case DATA_TYPE_BOOL:		m_pBase.Set<bool>(extract<bool>(oValue), iOffset); break;
+		case DATA_TYPE_CHAR:		m_pBase.Set<char>(extract<char>(oValue), iOffset); break;
+		case DATA_TYPE_UCHAR:		m_pBase.Set<unsigned char>(extract<unsigned char>(oValue), iOffset); break;
+		case DATA_TYPE_SHORT:		m_pBase.Set<short>(extract<short>(oValue), iOffset); break;
+		case DATA_TYPE_USHORT:		m_pBase.Set<unsigned short>(extract<unsigned short>(oValue), iOffset); break;
+		case DATA_TYPE_INT:			m_pBase.Set<int>(extract<int>(oValue), iOffset); break;
+		case DATA_TYPE_UINT:		m_pBase.Set<unsigned int>(extract<unsigned int>(oValue), iOffset); break;
+		case DATA_TYPE_LONG:		m_pBase.Set<long>(extract<long>(oValue), iOffset); break;
+		case DATA_TYPE_ULONG:		m_pBase.Set<unsigned long>(extract<unsigned long>(oValue), iOffset); break;
+		case DATA_TYPE_LONG_LONG:	m_pBase.Set<long long>(extract<long long>(oValue), iOffset); break;
+		case DATA_TYPE_ULONG_LONG:	m_pBase.Set<unsigned long long>(extract<unsigned long long>(oValue), iOffset); break;
+		case DATA_TYPE_FLOAT:		m_pBase.Set<float>(extract<float>(oValue), iOffset); break;
+		case DATA_TYPE_DOUBLE:		m_pBase.Set<double>(extract<double>(oValue), iOffset); break;
+		case DATA_TYPE_POINTER:		m_pBase.Set<unsigned long>(ExtractAddress(oValue), iOffset); break;
+	}
+}
+
+int CArrayView::GetBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+	CArrayView* pSelf = extract<CArrayView*>(self);
+
+	const char* szFormat = GetFormat(pSelf->m_eType);
+	if (!szFormat)
+	{
+		PyErr_SetString(PyExc_BufferError, "Only numeric arrays can be exported as a buffer.");
+		view->obj = NULL;
+		return -1;
+	}
+
+	if (pSelf->m_iLength == -1)
+	{
+		PyErr_SetString(PyExc_BufferError, "The length of the array is unknown.");
+		view->obj = NULL;
+		return -1;
+	}
+
+	int iItemSize = GetItemSize(pSelf->m_eType);
+	bool bContiguous = pSelf->m_iStride == iItemSize;
+	if (!bContiguous && (flags & PyBUF_STRIDES) != PyBUF_STRIDES)
+	{
+		PyErr_SetString(PyExc_BufferError, "The array is not contiguous.");
+		view->obj = NULL;
+		return -1;
+	}
+
+	Py_INCREF(self);
+	view->obj = self;
+	view->buf = (void *) pSelf->m_pBase.m_ulAddr;
+	view->len = pSelf->m_iLength * iItemSize;
+	view->readonly = 0;
+	view->itemsize = iItemSize;
+	view->format = (flags & PyBUF_FORMAT) ? (char *) szFormat : NULL;
+	view->ndim = 1;
+	view->shape = (flags & PyBUF_ND) ? &pSelf->m_shape : NULL;
+	view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? &pSelf->m_strides : NULL;
+	view->suboffsets = NULL;
+	view->internal = NULL;
+	return 0;
+}
+
+void CArrayView::ExportBuffer(object cls)
+{
+	static PyBufferProcs s_BufferProcs = { &CArrayView::GetBuffer, NULL };
+	((PyTypeObject *) cls.ptr())->tp_as_buffer = &s_BufferProcs;
+}
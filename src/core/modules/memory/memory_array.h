@@ -0,0 +1,84 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _MEMORY_ARRAY_H
+#define _MEMORY_ARRAY_H
+
+// ============================================================================
+// >> INCLUDES
+// ============================================================================
+// Memory
+#include "memory_pointer.h"
+
+// DynamicHooks
+#include "convention.h"
+
+
+// ============================================================================
+// >> CArrayView
+// ============================================================================
+// A typed view of a native array in memory. Elements are accessed directly
+// at base + index * stride, so no Python objects are created per access.
+class CArrayView
+{
+public:
+	CArrayView(object oPtr, DataType_t eType, object oLength=object(), int iStride=0);
+
+	int __len__();
+	object __getitem__(object oIndex);
+	void __setitem__(int iIndex, object oValue);
+	list ToList();
+
+	CPointer* GetPointer();
+	object GetLength();
+	DataType_t GetType() { return m_eType; }
+	int GetStride() { return m_iStride; }
+
+	static int GetItemSize(DataType_t eType);
+	static const char* GetFormat(DataType_t eType);
+	static void ExportBuffer(object cls);
+
+private:
+	int ValidateIndex(int iIndex);
+	object GetItem(int iIndex);
+	void SetItem(int iIndex, object oValue);
+
+	static int GetBuffer(PyObject* self, Py_buffer* view, int flags);
+
+private:
+	CPointer m_pBase;
+	DataType_t m_eType;
+
+	// -1 if the length is unknown
+	int m_iLength;
+	int m_iStride;
+
+	// Used as shape and strides of exported buffers
+	Py_ssize_t m_shape;
+	Py_ssize_t m_strides;
+};
+
+#endif // _MEMORY_ARRAY_H
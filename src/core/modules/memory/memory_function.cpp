@@ -49,12 +49,6 @@
 #include "utilities/call_python.h"
 
 
-// ============================================================================
-// >> EXTERNALS
-// ============================================================================
-extern std::map<CHook *, std::map<HookType_t, std::list<object> > > g_mapCallbacks;
-
-
 // ============================================================================
 // >> GLOBAL VARIABLES
 // ============================================================================
@@ -373,11 +367,21 @@ CHook* HookFunctionHelper(void* addr, ICallingConvention* pConv)
 	return result;
 }
 
-void CFunction::AddHook(HookType_t eType, PyObject* pCallable)
+void CFunction::AddHook(HookType_t eType, PyObject* pCallable, object oFilter)
 {
 	if (!IsHookable())
 		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Function is not hookable.")
 
+	// Filters are tested against the first argument
+	if (!oFilter.is_none())
+	{
+		if (m_pCallingConvention->m_vecArgTypes.empty() || m_pCallingConvention->m_vecArgTypes[0] != DATA_TYPE_POINTER)
+			BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Hook filters require the first argument to be a pointer.")
+
+		if (!extract<CHookFilter*>(oFilter).check())
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "The hook filter must be a HookFilter instance.")
+	}
+
 	Validate();
 	CHook* pHook = GetHookManager()->FindHook((void *) m_ulAddr);
 
@@ -415,7 +419,7 @@ void CFunction::AddHook(HookType_t eType, PyObject* pCallable)
 
 	// Add the hook handler. If it's already added, it won't be added twice
 	pHook->AddCallback(eType, (HookHandlerFn *) (void *) &SP_HookHandler);
-	g_mapCallbacks[pHook][eType].push_back(object(handle<>(borrowed(pCallable))));
+	g_mapCallbacks[pHook][eType].push_back(HookCallback_t(oCallback, oFilter));
 }
 
 bool CFunction::AddHook(HookType_t eType, HookHandlerFn* pFunc)
@@ -443,7 +447,55 @@ void CFunction::RemoveHook(HookType_t eType, PyObject* pCallable)
 	if (!pHook)
 		return;
 
-	g_mapCallbacks[pHook][eType].remove(object(handle<>(borrowed(pCallable))));
+	object oCallback = object(handle<>(borrowed(pCallable)));
+	HookCallbackList& callbacks = g_mapCallbacks[pHook][eType];
+	for (HookCallbackList::iterator it=callbacks.begin(); it != callbacks.end();)
+	{
+		if (it->m_oCallback == oCallback)
+			it = callbacks.erase(it);
+		else
+			++it;
+	}
+}
+
+void CFunction::AddHookRule(HookType_t eType, object oRule)
+{
+	if (!IsHookable())
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Function is not hookable.")
+
+	Validate();
+
+	extract<CHookRule*> rule(oRule);
+	if (!rule.check())
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "The rule must be a HookRule instance.")
+
+	rule()->Validate(m_pCallingConvention);
+
+	CHook* pHook = GetHookManager()->FindHook((void *) m_ulAddr);
+	if (!pHook) {
+		pHook = HookFunctionHelper((void *) m_ulAddr, m_pCallingConvention);
+	}
+
+	// Rules are evaluated by the same handler as the Python callbacks
+	pHook->AddCallback(eType, (HookHandlerFn *) (void *) &SP_HookHandler);
+	g_mapRules[pHook][eType].push_back(HookRule_t(oRule));
+}
+
+void CFunction::RemoveHookRule(HookType_t eType, object oRule)
+{
+	Validate();
+	CHook* pHook = GetHookManager()->FindHook((void *) m_ulAddr);
+	if (!pHook)
+		return;
+
+	HookRuleList& rules = g_mapRules[pHook][eType];
+	for (HookRuleList::iterator it=rules.begin(); it != rules.end();)
+	{
+		if (it->m_oRule == oRule)
+			it = rules.erase(it);
+		else
+			++it;
+	}
 }
 
 void CFunction::DeleteHook()
@@ -453,6 +505,7 @@ void CFunction::DeleteHook()
 		return;
 
 	g_mapCallbacks.erase(pHook);
+	g_mapRules.erase(pHook);
 
 	ICallingConventionWrapper *pConv = dynamic_cast<ICallingConventionWrapper *>(pHook->m_pCallingConvention);
 	if (pConv)
@@ -75,7 +75,7 @@ public:
 	object CallTrampoline(boost::python::tuple args, dict kw);
 	object SkipHooks(boost::python::tuple args, dict kw);
 
-	void AddHook(HookType_t eType, PyObject* pCallable);
+	void AddHook(HookType_t eType, PyObject* pCallable, object oFilter=object());
 	void RemoveHook(HookType_t eType, PyObject* pCallable);
 
 	void AddPreHook(PyObject* pCallable)
@@ -90,6 +90,9 @@ public:
 	void RemovePostHook(PyObject* pCallable)
 	{ RemoveHook(HOOKTYPE_POST, pCallable);	}
 
+	void AddHookRule(HookType_t eType, object oRule);
+	void RemoveHookRule(HookType_t eType, object oRule);
+
 	void DeleteHook();
 
 	bool AddHook(HookType_t eType, HookHandlerFn* pFunc);
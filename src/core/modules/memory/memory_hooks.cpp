@@ -32,6 +32,9 @@
 #include "memory_pointer.h"
 #include "utilities/wrap_macros.h"
 #include "utilities/sp_util.h"
+#include "modules/core/core_profiler.h"
+#include "modules/entities/entities_entity.h"
+#include "utilities/conversions.h"
 
 #include "boost/python.hpp"
 using namespace boost::python;
@@ -40,8 +43,8 @@ using namespace boost::python;
 // ============================================================================
 // >> GLOBAL VARIABLES
 // ============================================================================
-// g_mapCallbacks[<CHook *>][<HookType_t>] -> [<object>, <object>, ...]
-std::map<CHook *, std::map<HookType_t, std::list<object> > > g_mapCallbacks;
+std::map<CHook *, std::map<HookType_t, HookCallbackList> > g_mapCallbacks;
+std::map<CHook *, std::map<HookType_t, HookRuleList> > g_mapRules;
 
 bool g_HooksDisabled;
 
@@ -75,6 +78,59 @@ object GetArgument(CHook* pHook, int iIndex)
 	return object(pHook->GetArgument<T>(iIndex));
 }
 
+void SetArgumentFromObject(CHook* pHook, int iIndex, object value)
+{
+	switch(pHook->m_pCallingConvention->m_vecArgTypes[iIndex])
+	{
+		case DATA_TYPE_BOOL:		SetArgument<bool>(pHook, iIndex, value); break;
+		case DATA_TYPE_CHAR:		SetArgument<char>(pHook, iIndex, value); break;
+		case DATA_TYPE_UCHAR:		SetArgument<unsigned char>(pHook, iIndex, value); break;
+		case DATA_TYPE_SHORT:		SetArgument<short>(pHook, iIndex, value); break;
+		case DATA_TYPE_USHORT:		SetArgument<unsigned short>(pHook, iIndex, value); break;
+		case DATA_TYPE_INT:			SetArgument<int>(pHook, iIndex, value); break;
+		case DATA_TYPE_UINT:		SetArgument<unsigned int>(pHook, iIndex, value); break;
+		case DATA_TYPE_LONG:		SetArgument<long>(pHook, iIndex, value); break;
+		case DATA_TYPE_ULONG:		SetArgument<unsigned long>(pHook, iIndex, value); break;
+		case DATA_TYPE_LONG_LONG:	SetArgument<long long>(pHook, iIndex, value); break;
+		case DATA_TYPE_ULONG_LONG:	SetArgument<unsigned long long>(pHook, iIndex, value); break;
+		case DATA_TYPE_FLOAT:		SetArgument<float>(pHook, iIndex, value); break;
+		case DATA_TYPE_DOUBLE:		SetArgument<double>(pHook, iIndex, value); break;
+		case DATA_TYPE_POINTER:
+		{
+			SetArgument<unsigned long>(pHook, iIndex, object(ExtractAddress(value)));
+		} break;
+		case DATA_TYPE_STRING:		SetArgument<const char *>(pHook, iIndex, value); break;
+		default: BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unknown type.")
+	}
+}
+
+void SetReturnValueFromObject(CHook* pHook, object value)
+{
+	switch(pHook->m_pCallingConvention->m_returnType)
+	{
+		case DATA_TYPE_VOID:		break;
+		case DATA_TYPE_BOOL:		SetReturnValue<bool>(pHook, value); break;
+		case DATA_TYPE_CHAR:		SetReturnValue<char>(pHook, value); break;
+		case DATA_TYPE_UCHAR:		SetReturnValue<unsigned >(pHook, value); break;
+		case DATA_TYPE_SHORT:		SetReturnValue<short>(pHook, value); break;
+		case DATA_TYPE_USHORT:		SetReturnValue<unsigned short>(pHook, value); break;
+		case DATA_TYPE_INT:			SetReturnValue<int>(pHook, value); break;
+		case DATA_TYPE_UINT:		SetReturnValue<unsigned int>(pHook, value); break;
+		case DATA_TYPE_LONG:		SetReturnValue<long>(pHook, value); break;
+		case DATA_TYPE_ULONG:		SetReturnValue<unsigned long>(pHook, value); break;
+		case DATA_TYPE_LONG_LONG:	SetReturnValue<long long>(pHook, value); break;
+		case DATA_TYPE_ULONG_LONG:	SetReturnValue<unsigned long long>(pHook, value); break;
+		case DATA_TYPE_FLOAT:		SetReturnValue<float>(pHook, value); break;
+		case DATA_TYPE_DOUBLE:		SetReturnValue<double>(pHook, value); break;
+		case DATA_TYPE_POINTER:
+		{
+			pHook->SetReturnValue<unsigned long>(ExtractAddress(value));
+		} break;
+		case DATA_TYPE_STRING:		SetReturnValue<const char*>(pHook, value); break;
+		default: BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unknown type.")
+	}
+}
+
 
 // ============================================================================
 // >> SP_HookHandler
@@ -84,9 +140,66 @@ bool SP_HookHandler(HookType_t eHookType, CHook* pHook)
 	if (g_HooksDisabled)
 		return false;
 
-	std::list<object> callbacks = g_mapCallbacks[pHook][eHookType];
+	// Native rules are evaluated before any callback
+	HookRuleList& rules = g_mapRules[pHook][eHookType];
+	for (HookRuleList::iterator it=rules.begin(); it != rules.end(); ++it)
+	{
+		CHookRule* pRule = it->m_pRule;
+		if (!pRule->Matches(pHook))
+			continue;
+
+		g_Metrics.Increment(METRIC_HOOK_RULE_MATCHES);
+
+		switch (pRule->GetAction())
+		{
+			case RULE_ACTION_RETURN:
+			{
+				BEGIN_BOOST_PY()
+					SetReturnValueFromObject(pHook, pRule->GetValue());
+					return true;
+				END_BOOST_PY_NORET()
+			} break;
+			case RULE_ACTION_SET_ARGUMENT:
+			{
+				BEGIN_BOOST_PY()
+					SetArgumentFromObject(pHook, pRule->GetArgument(), pRule->GetValue());
+				END_BOOST_PY_NORET()
+			} break;
+			case RULE_ACTION_SKIP_CALLBACKS:
+				return false;
+		}
+	}
+
+	HookCallbackList& registered = g_mapCallbacks[pHook][eHookType];
 
 	// No need to do all this stuff, if there is no callback registered
+	if (registered.empty())
+		return false;
+
+	// Collect the callbacks whose filter accepts the "this" pointer. Copying
+	// them also protects the loop below from callbacks that add or remove
+	// hooks.
+	std::list<object> callbacks;
+	void* pThis = NULL;
+	bool bThisRetrieved = false;
+	for (HookCallbackList::iterator it=registered.begin(); it != registered.end(); ++it)
+	{
+		if (it->m_pFilter)
+		{
+			if (!bThisRetrieved)
+			{
+				pThis = pHook->GetArgument<void*>(0);
+				bThisRetrieved = true;
+			}
+
+			if (!it->m_pFilter->Test(pThis))
+				continue;
+		}
+
+		callbacks.push_back(it->m_oCallback);
+	}
+
+	// Don't enter Python at all, if no filter matched
 	if (callbacks.empty())
 		return false;
 
@@ -115,43 +228,26 @@ bool SP_HookHandler(HookType_t eHookType, CHook* pHook)
 		}
 	}
 	
-	CStackData stackdata = CStackData(pHook);
+	// All callbacks share the same StackData object, so arguments that have
+	// been converted by one callback are reused by the others
+	object stackdata = object(CStackData(pHook));
 	bool bOverride = false;
 	for (std::list<object>::iterator it=callbacks.begin(); it != callbacks.end(); ++it)
 	{
 		BEGIN_BOOST_PY()
 			object pyretval;
-			if (eHookType == HOOKTYPE_PRE)
-				pyretval = (*it)(stackdata);
-			else
-				pyretval = (*it)(stackdata, retval);
+			{
+				CCallbackProfileScope profile_scope(it->ptr(), FRAME_SUBSYSTEM_HOOKS);
+				if (eHookType == HOOKTYPE_PRE)
+					pyretval = (*it)(stackdata);
+				else
+					pyretval = (*it)(stackdata, retval);
+			}
 
 			if (!pyretval.is_none())
 			{
 				bOverride = true;
-				switch(pHook->m_pCallingConvention->m_returnType)
-				{
-					case DATA_TYPE_VOID:		break;
-					case DATA_TYPE_BOOL:		SetReturnValue<bool>(pHook, pyretval); break;
-					case DATA_TYPE_CHAR:		SetReturnValue<char>(pHook, pyretval); break;
-					case DATA_TYPE_UCHAR:		SetReturnValue<unsigned >(pHook, pyretval); break;
-					case DATA_TYPE_SHORT:		SetReturnValue<short>(pHook, pyretval); break;
-					case DATA_TYPE_USHORT:		SetReturnValue<unsigned short>(pHook, pyretval); break;
-					case DATA_TYPE_INT:			SetReturnValue<int>(pHook, pyretval); break;
-					case DATA_TYPE_UINT:		SetReturnValue<unsigned int>(pHook, pyretval); break;
-					case DATA_TYPE_LONG:		SetReturnValue<long>(pHook, pyretval); break;
-					case DATA_TYPE_ULONG:		SetReturnValue<unsigned long>(pHook, pyretval); break;
-					case DATA_TYPE_LONG_LONG:	SetReturnValue<long long>(pHook, pyretval); break;
-					case DATA_TYPE_ULONG_LONG:	SetReturnValue<unsigned long long>(pHook, pyretval); break;
-					case DATA_TYPE_FLOAT:		SetReturnValue<float>(pHook, pyretval); break;
-					case DATA_TYPE_DOUBLE:		SetReturnValue<double>(pHook, pyretval); break;
-					case DATA_TYPE_POINTER:
-					{
-						pHook->SetReturnValue<unsigned long>(ExtractAddress(pyretval));
-					} break;
-					case DATA_TYPE_STRING:		SetReturnValue<const char*>(pHook, pyretval); break;
-					default: BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unknown type.")
-				}
+				SetReturnValueFromObject(pHook, pyretval);
 			}
 		END_BOOST_PY_NORET()
 	}
@@ -159,12 +255,367 @@ bool SP_HookHandler(HookType_t eHookType, CHook* pHook)
 }
 
 
+// ============================================================================
+// >> HookCallback_t
+// ============================================================================
+HookCallback_t::HookCallback_t(object oCallback, object oFilter):
+	m_oCallback(oCallback),
+	m_oFilter(oFilter),
+	m_pFilter(NULL)
+{
+	if (!oFilter.is_none())
+		m_pFilter = extract<CHookFilter*>(oFilter);
+}
+
+
+// ============================================================================
+// >> CHookFilter
+// ============================================================================
+CHookFilter::CHookFilter(object indexes, object classnames, object vtable, object datamaps)
+{
+	m_bIndexes = !indexes.is_none();
+	if (m_bIndexes)
+	{
+		list items(indexes);
+		for (int i=0; i < len(items); ++i)
+			m_Indexes.insert(extract<unsigned int>(items[i]));
+	}
+
+	if (!classnames.is_none())
+	{
+		list items(classnames);
+		for (int i=0; i < len(items); ++i)
+			m_Classnames.insert(extract<std::string>(items[i]));
+	}
+
+	m_pVTable = vtable.is_none() ? NULL : (void *) ExtractAddress(vtable, true);
+
+	if (!datamaps.is_none())
+	{
+		list items(datamaps);
+		for (int i=0; i < len(items); ++i)
+			m_DataMaps.insert(extract<std::string>(items[i]));
+	}
+}
+
+bool CHookFilter::Test(void* pThis)
+{
+	if (!pThis)
+		return false;
+
+	// Cheapest tests first
+	void* pVTable = *(void **) pThis;
+	if (m_pVTable && pVTable != m_pVTable)
+		return false;
+
+	if (!m_DataMaps.empty() && !TestDataMap(pVTable, pThis))
+		return false;
+
+	if (m_bIndexes)
+	{
+		unsigned int iIndex;
+		if (!IndexFromBaseEntity((CBaseEntity *) pThis, iIndex) || m_Indexes.find(iIndex) == m_Indexes.end())
+			return false;
+	}
+
+	if (!m_Classnames.empty())
+	{
+		const char* szClassname = IServerUnknownExt::GetClassname((IServerUnknown *) pThis);
+		if (!szClassname || m_Classnames.find(szClassname) == m_Classnames.end())
+			return false;
+	}
+
+	return true;
+}
+
+bool CHookFilter::TestPointer(object oPointer)
+{
+	return Test((void *) ExtractAddress(oPointer));
+}
+
+bool CHookFilter::TestDataMap(void* pVTable, void* pThis)
+{
+	boost::unordered_map<void*, bool>::iterator it = m_DataMapResults.find(pVTable);
+	if (it != m_DataMapResults.end())
+		return it->second;
+
+	// Entities of the same class share their vtable and their datamap
+	bool bResult = false;
+	datamap_t* pDataMap = ((CBaseEntityWrapper *) pThis)->GetDataDescMap();
+	for (; pDataMap && !bResult; pDataMap = pDataMap->baseMap)
+	{
+		if (pDataMap->dataClassName && m_DataMaps.find(pDataMap->dataClassName) != m_DataMaps.end())
+			bResult = true;
+	}
+
+	m_DataMapResults[pVTable] = bResult;
+	return bResult;
+}
+
+void CHookFilter::AddIndex(unsigned int iIndex)
+{
+	m_bIndexes = true;
+	m_Indexes.insert(iIndex);
+}
+
+void CHookFilter::RemoveIndex(unsigned int iIndex)
+{
+	m_Indexes.erase(iIndex);
+}
+
+bool CHookFilter::HasIndex(unsigned int iIndex)
+{
+	return m_Indexes.find(iIndex) != m_Indexes.end();
+}
+
+
+// ============================================================================
+// >> CHookRule
+// ============================================================================
+template<class T>
+inline double ReadRuleValue(CHook* pHook, unsigned int iArgument, int iOffset)
+{
+	if (iOffset < 0)
+		return (double) pHook->GetArgument<T>(iArgument);
+
+	return (double) *(T *) (pHook->GetArgument<unsigned long>(iArgument) + iOffset);
+}
+
+inline double ExtractRuleValue(object value)
+{
+	extract<double> number(value);
+	if (number.check())
+		return number();
+
+	return (double) ExtractAddress(value);
+}
+
+// Raises an exception if the value can't be converted when the rule matches
+static void CheckRuleValue(DataType_t eType, object value)
+{
+	bool bValid;
+	switch (eType)
+	{
+		case DATA_TYPE_VOID:		bValid = true; break;
+		case DATA_TYPE_POINTER:		ExtractAddress(value); bValid = true; break;
+		case DATA_TYPE_STRING:		bValid = extract<const char*>(value).check(); break;
+		default:					bValid = extract<double>(value).check(); break;
+	}
+
+	if (!bValid)
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "The value of the rule doesn't match the type %d.", (int) eType)
+}
+
+CHookRule::CHookRule(HookRuleAction_t eAction, object value, int iArgument)
+{
+	if (eAction == RULE_ACTION_SET_ARGUMENT && iArgument < 0)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "An argument index is required to set an argument.")
+
+	m_eAction = eAction;
+	m_oValue = value;
+	m_iArgument = iArgument;
+	m_iRegistrations = 0;
+}
+
+void CHookRule::CheckNotRegistered()
+{
+	if (IsRegistered())
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Conditions can't be changed while the rule is added to a function.")
+}
+
+void CHookRule::AddCondition(unsigned int iArgument, HookRuleOperator_t eOperator, object value,
+	int iOffset, object type, bool bEntityIndex)
+{
+	CheckNotRegistered();
+
+	HookRuleCondition_t condition;
+	condition.m_iArgument = iArgument;
+	condition.m_iOffset = iOffset;
+	condition.m_bArgumentType = type.is_none();
+	condition.m_eType = condition.m_bArgumentType ? DATA_TYPE_VOID : extract<DataType_t>(type);
+	condition.m_bEntityIndex = bEntityIndex;
+	condition.m_eOperator = eOperator;
+	condition.m_dValue = 0;
+
+	if (iOffset >= 0 && condition.m_bArgumentType && !bEntityIndex)
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "A type is required if an offset is given.")
+
+	if (condition.m_eType == DATA_TYPE_STRING)
+		BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Strings can't be compared by hook rules.")
+
+	if (eOperator == RULE_OPERATOR_IN || eOperator == RULE_OPERATOR_NOT_IN)
+	{
+		list values(value);
+		for (int i=0; i < len(values); ++i)
+			condition.m_Values.insert(ExtractRuleValue(values[i]));
+	}
+	else
+	{
+		condition.m_dValue = ExtractRuleValue(value);
+	}
+
+	m_vecConditions.push_back(condition);
+}
+
+void CHookRule::ClearConditions()
+{
+	CheckNotRegistered();
+	m_vecConditions.clear();
+}
+
+void CHookRule::Validate(ICallingConvention* pConvention)
+{
+	unsigned int iCount = (unsigned int) pConvention->m_vecArgTypes.size();
+	if (m_eAction == RULE_ACTION_SET_ARGUMENT)
+	{
+		if ((unsigned int) m_iArgument >= iCount)
+			BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Argument index %d is out of range.", m_iArgument)
+
+		CheckRuleValue(pConvention->m_vecArgTypes[m_iArgument], m_oValue);
+	}
+	else if (m_eAction == RULE_ACTION_RETURN)
+	{
+		CheckRuleValue(pConvention->m_returnType, m_oValue);
+	}
+
+	for (std::vector<HookRuleCondition_t>::iterator it=m_vecConditions.begin(); it != m_vecConditions.end(); ++it)
+	{
+		if (it->m_iArgument >= iCount)
+			BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Argument index %d is out of range.", it->m_iArgument)
+
+		DataType_t eType = pConvention->m_vecArgTypes[it->m_iArgument];
+		if ((it->m_iOffset >= 0 || it->m_bEntityIndex) && eType != DATA_TYPE_POINTER)
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Argument %d must be a pointer.", it->m_iArgument)
+
+		if (it->m_bArgumentType && (eType == DATA_TYPE_STRING || eType == DATA_TYPE_VOID))
+			BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Argument %d can't be compared by hook rules.", it->m_iArgument)
+	}
+}
+
+bool CHookRule::Matches(CHook* pHook)
+{
+	for (std::vector<HookRuleCondition_t>::iterator it=m_vecConditions.begin(); it != m_vecConditions.end(); ++it)
+	{
+		double dValue;
+		if (!ReadCondition(pHook, *it, dValue))
+			return false;
+
+		bool bResult;
+		switch (it->m_eOperator)
+		{
+			case RULE_OPERATOR_EQUAL:			bResult = dValue == it->m_dValue; break;
+			case RULE_OPERATOR_NOT_EQUAL:		bResult = dValue != it->m_dValue; break;
+			case RULE_OPERATOR_LESS:			bResult = dValue < it->m_dValue; break;
+			case RULE_OPERATOR_LESS_EQUAL:		bResult = dValue <= it->m_dValue; break;
+			case RULE_OPERATOR_GREATER:			bResult = dValue > it->m_dValue; break;
+			case RULE_OPERATOR_GREATER_EQUAL:	bResult = dValue >= it->m_dValue; break;
+			case RULE_OPERATOR_IN:				bResult = it->m_Values.find(dValue) != it->m_Values.end(); break;
+			case RULE_OPERATOR_NOT_IN:			bResult = it->m_Values.find(dValue) == it->m_Values.end(); break;
+			default: bResult = false;
+		}
+
+		if (!bResult)
+			return false;
+	}
+
+	return true;
+}
+
+bool CHookRule::ReadCondition(CHook* pHook, const HookRuleCondition_t& condition, double& dResult)
+{
+	unsigned int iArgument = condition.m_iArgument;
+	int iOffset = condition.m_iOffset;
+	if (iOffset >= 0 && !pHook->GetArgument<void *>(iArgument))
+		return false;
+
+	if (condition.m_bEntityIndex)
+	{
+		void* pEntity = iOffset < 0 ? pHook->GetArgument<void *>(iArgument) :
+			*(void **) (pHook->GetArgument<unsigned long>(iArgument) + iOffset);
+
+		unsigned int iIndex;
+		if (!pEntity || !IndexFromBaseEntity((CBaseEntity *) pEntity, iIndex))
+			return false;
+
+		dResult = (double) iIndex;
+		return true;
+	}
+
+	DataType_t eType = condition.m_bArgumentType ?
+		pHook->m_pCallingConvention->m_vecArgTypes[iArgument] : condition.m_eType;
+
+	switch (eType)
+	{
+		case DATA_TYPE_BOOL:		dResult = ReadRuleValue<bool>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_CHAR:		dResult = ReadRuleValue<char>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_UCHAR:		dResult = ReadRuleValue<unsigned char>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_SHORT:		dResult = ReadRuleValue<short>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_USHORT:		dResult = ReadRuleValue<unsigned short>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_INT:			dResult = ReadRuleValue<int>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_UINT:		dResult = ReadRuleValue<unsigned int>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_LONG:		dResult = ReadRuleValue<long>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_ULONG:		dResult = ReadRuleValue<unsigned long>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_LONG_LONG:	dResult = ReadRuleValue<long long>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_ULONG_LONG:	dResult = ReadRuleValue<unsigned long long>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_FLOAT:		dResult = ReadRuleValue<float>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_DOUBLE:		dResult = ReadRuleValue<double>(pHook, iArgument, iOffset); break;
+		case DATA_TYPE_POINTER:		dResult = ReadRuleValue<unsigned long>(pHook, iArgument, iOffset); break;
+		default: return false;
+	}
+
+	return true;
+}
+
+
+// ============================================================================
+// >> HookRule_t
+// ============================================================================
+HookRule_t::HookRule_t(object oRule):
+	m_oRule(oRule)
+{
+	m_pRule = extract<CHookRule*>(oRule);
+	m_pRule->m_iRegistrations++;
+}
+
+HookRule_t::HookRule_t(const HookRule_t& other):
+	m_oRule(other.m_oRule),
+	m_pRule(other.m_pRule)
+{
+	m_pRule->m_iRegistrations++;
+}
+
+HookRule_t::~HookRule_t()
+{
+	m_pRule->m_iRegistrations--;
+}
+
+HookRule_t& HookRule_t::operator=(const HookRule_t& other)
+{
+	other.m_pRule->m_iRegistrations++;
+	m_pRule->m_iRegistrations--;
+	m_oRule = other.m_oRule;
+	m_pRule = other.m_pRule;
+	return *this;
+}
+
+
 // ============================================================================
 // >> CStackData
 // ============================================================================
 CStackData::CStackData(CHook* pHook)
 {
 	m_pHook = pHook;
+	ClearCache();
+}
+
+void CStackData::ClearCache()
+{
+	for (int i=0; i < STACK_DATA_CACHE_SIZE; ++i)
+	{
+		m_Cache[i] = object();
+		m_bCached[i] = false;
+		m_pPointers[i] = NULL;
+	}
 }
 
 object CStackData::GetItem(unsigned int iIndex)
@@ -172,13 +623,22 @@ object CStackData::GetItem(unsigned int iIndex)
 	if (iIndex >= (unsigned int) m_pHook->m_pCallingConvention->m_vecArgTypes.size())
 		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Index out of range.")
 
-	// Argument already cached?
-	object retval;
-	//object retval = m_mapCache[iIndex];
-	//if (retval)
-	//	return retval;
+	// Argument already cached? Pointers are mutable (e.g. Pointer.__iadd__)
+	// and StackData is shared by all callbacks, so a cached pointer is only
+	// returned if it still points to the argument's address.
+	DataType_t eType = m_pHook->m_pCallingConvention->m_vecArgTypes[iIndex];
+	bool bCacheable = iIndex < STACK_DATA_CACHE_SIZE;
+	if (bCacheable && m_bCached[iIndex])
+	{
+		if (eType != DATA_TYPE_POINTER
+			|| (unsigned long) *m_pPointers[iIndex] == m_pHook->GetArgument<unsigned long>(iIndex))
+		{
+			return m_Cache[iIndex];
+		}
+	}
 
-	switch(m_pHook->m_pCallingConvention->m_vecArgTypes[iIndex])
+	object retval;
+	switch(eType)
 	{
 		case DATA_TYPE_BOOL:		retval = GetArgument<bool>(m_pHook, iIndex); break;
 		case DATA_TYPE_CHAR:		retval = GetArgument<char>(m_pHook, iIndex); break;
@@ -197,7 +657,14 @@ object CStackData::GetItem(unsigned int iIndex)
 		case DATA_TYPE_STRING:		retval = GetArgument<const char *>(m_pHook, iIndex); break;
 		default: BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unknown type.") break;
 	}
-	//m_mapCache[iIndex] = retval;
+
+	if (bCacheable)
+	{
+		m_Cache[iIndex] = retval;
+		m_bCached[iIndex] = true;
+		if (eType == DATA_TYPE_POINTER)
+			m_pPointers[iIndex] = extract<CPointer*>(retval);
+	}
 	return retval;
 }
 
@@ -206,28 +673,13 @@ void CStackData::SetItem(unsigned int iIndex, object value)
 	if (iIndex >= (unsigned int) m_pHook->m_pCallingConvention->m_vecArgTypes.size())
 		BOOST_RAISE_EXCEPTION(PyExc_IndexError, "Index out of range.")
 
-	// Update cache
-	//m_mapCache[iIndex] = value;
-	switch(m_pHook->m_pCallingConvention->m_vecArgTypes[iIndex])
-	{
-		case DATA_TYPE_BOOL:		SetArgument<bool>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_CHAR:		SetArgument<char>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_UCHAR:		SetArgument<unsigned char>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_SHORT:		SetArgument<short>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_USHORT:		SetArgument<unsigned short>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_INT:			SetArgument<int>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_UINT:		SetArgument<unsigned int>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_LONG:		SetArgument<long>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_ULONG:		SetArgument<unsigned long>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_LONG_LONG:	SetArgument<long long>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_ULONG_LONG:	SetArgument<unsigned long long>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_FLOAT:		SetArgument<float>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_DOUBLE:		SetArgument<double>(m_pHook, iIndex, value); break;
-		case DATA_TYPE_POINTER:
-		{
-			SetArgument<unsigned long>(m_pHook, iIndex, object(ExtractAddress(value)));
-		} break;
-		case DATA_TYPE_STRING:		SetArgument<const char *>(m_pHook, iIndex, value); break;
-		default: BOOST_RAISE_EXCEPTION(PyExc_TypeError, "Unknown type.")
+	// The value is converted when it's written, so read it again next time
+	if (iIndex < STACK_DATA_CACHE_SIZE)
+	{
+		m_Cache[iIndex] = object();
+		m_bCached[iIndex] = false;
+		m_pPointers[iIndex] = NULL;
 	}
+
+	SetArgumentFromObject(m_pHook, iIndex, value);
 }
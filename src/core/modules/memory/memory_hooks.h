@@ -32,16 +32,27 @@
 //---------------------------------------------------------------------------------
 #include <list>
 #include <map>
+#include <string>
+#include <vector>
 
 #include "boost/python.hpp"
 using namespace boost::python;
 
+#include "boost/unordered_map.hpp"
+#include "boost/unordered_set.hpp"
+
 // DynamicHooks
 #include "hook.h"
 
 //---------------------------------------------------------------------------------
 // Classes
 //---------------------------------------------------------------------------------
+class CPointer;
+
+// Number of arguments CStackData caches. Arguments at higher indexes are
+// converted on every access.
+#define STACK_DATA_CACHE_SIZE 8
+
 class CStackData
 {
 public:
@@ -72,14 +83,184 @@ public:
 
 	void SetUsePreRegisters(bool value)
 	{
+		// The arguments are read from other registers now
+		if (m_pHook->m_bUsePreRegisters != value)
+			ClearCache();
+
 		m_pHook->m_bUsePreRegisters = value;
 	}
 
+	void ClearCache();
+
 protected:
-	CHook*                m_pHook;
-	std::map<int, object> m_mapCache;
+	CHook*		m_pHook;
+	object		m_Cache[STACK_DATA_CACHE_SIZE];
+	bool		m_bCached[STACK_DATA_CACHE_SIZE];
+
+	// The wrapped CPointer of cached pointer arguments
+	CPointer*	m_pPointers[STACK_DATA_CACHE_SIZE];
+};
+
+
+//---------------------------------------------------------------------------------
+// Tests the "this" pointer of an entity function before its callback is called.
+//
+// Each given predicate must match (indexes, classnames, vtable and datamap
+// classes). Within a predicate, one matching value is enough. The result of
+// the datamap test is cached per vtable, so it's only evaluated once per
+// entity class.
+//---------------------------------------------------------------------------------
+class CHookFilter
+{
+public:
+	CHookFilter(object indexes, object classnames, object vtable, object datamaps);
+
+	bool Test(void* pThis);
+	bool TestPointer(object oPointer);
+
+	void AddIndex(unsigned int iIndex);
+	void RemoveIndex(unsigned int iIndex);
+	bool HasIndex(unsigned int iIndex);
+
+private:
+	bool TestDataMap(void* pVTable, void* pThis);
+
+private:
+	boost::unordered_set<unsigned int>	m_Indexes;
+	bool								m_bIndexes;
+	boost::unordered_set<std::string>	m_Classnames;
+	void*								m_pVTable;
+	boost::unordered_set<std::string>	m_DataMaps;
+	boost::unordered_map<void*, bool>	m_DataMapResults;
+};
+
+
+//---------------------------------------------------------------------------------
+// A registered hook callback.
+//---------------------------------------------------------------------------------
+struct HookCallback_t
+{
+	HookCallback_t(object oCallback, object oFilter);
+
+	object			m_oCallback;
+
+	// Keeps the filter alive while the callback is registered
+	object			m_oFilter;
+	CHookFilter*	m_pFilter;
+};
+
+typedef std::list<HookCallback_t> HookCallbackList;
+
+// g_mapCallbacks[<CHook *>][<HookType_t>] -> [<HookCallback_t>, ...]
+extern std::map<CHook *, std::map<HookType_t, HookCallbackList> > g_mapCallbacks;
+
+
+//---------------------------------------------------------------------------------
+// Hook rules.
+//
+// A rule consists of conditions on the arguments and an action. Rules are
+// evaluated by SP_HookHandler before any Python callback is called, so
+// common patterns like blocking a function under a simple condition don't
+// need to enter Python at all.
+//---------------------------------------------------------------------------------
+enum HookRuleOperator_t
+{
+	RULE_OPERATOR_EQUAL,
+	RULE_OPERATOR_NOT_EQUAL,
+	RULE_OPERATOR_LESS,
+	RULE_OPERATOR_LESS_EQUAL,
+	RULE_OPERATOR_GREATER,
+	RULE_OPERATOR_GREATER_EQUAL,
+	RULE_OPERATOR_IN,
+	RULE_OPERATOR_NOT_IN
+};
+
+enum HookRuleAction_t
+{
+	// Override the return value. Neither the Python callbacks nor (in a
+	// pre-hook) the original function are called.
+	RULE_ACTION_RETURN,
+
+	// Change an argument and continue with the next rule
+	RULE_ACTION_SET_ARGUMENT,
+
+	// Don't call the Python callbacks, but leave the call untouched
+	RULE_ACTION_SKIP_CALLBACKS
+};
+
+struct HookRuleCondition_t
+{
+	unsigned int		m_iArgument;
+
+	// If >= 0, the argument is a pointer and the value is read at this offset
+	int					m_iOffset;
+
+	// Type of the value. Only used if m_bArgumentType is false.
+	DataType_t			m_eType;
+	bool				m_bArgumentType;
+
+	// Convert the pointer to an entity index before comparing it
+	bool				m_bEntityIndex;
+
+	HookRuleOperator_t	m_eOperator;
+	double				m_dValue;
+	boost::unordered_set<double> m_Values;
+};
+
+class CHookRule
+{
+public:
+	CHookRule(HookRuleAction_t eAction, object value, int iArgument);
+
+	void AddCondition(unsigned int iArgument, HookRuleOperator_t eOperator, object value,
+		int iOffset, object type, bool bEntityIndex);
+	void ClearConditions();
+	int GetConditionCount() { return (int) m_vecConditions.size(); }
+
+	HookRuleAction_t GetAction() { return m_eAction; }
+	bool IsRegistered() { return m_iRegistrations > 0; }
+	object GetValue() { return m_oValue; }
+	int GetArgument() { return m_iArgument; }
+
+	// Raises an exception if the rule can't be used with the given convention
+	void Validate(ICallingConvention* pConvention);
+
+	bool Matches(CHook* pHook);
+
+private:
+	bool ReadCondition(CHook* pHook, const HookRuleCondition_t& condition, double& dResult);
+
+	// Conditions have only been validated against the conventions of the
+	// functions the rule has been added to, so they can't be changed anymore
+	void CheckNotRegistered();
+
+	friend struct HookRule_t;
+
+private:
+	HookRuleAction_t					m_eAction;
+	object								m_oValue;
+	int									m_iArgument;
+	std::vector<HookRuleCondition_t>	m_vecConditions;
+	int									m_iRegistrations;
+};
+
+struct HookRule_t
+{
+	HookRule_t(object oRule);
+	HookRule_t(const HookRule_t& other);
+	~HookRule_t();
+
+	HookRule_t& operator=(const HookRule_t& other);
+
+	object		m_oRule;
+	CHookRule*	m_pRule;
 };
 
+typedef std::list<HookRule_t> HookRuleList;
+
+// g_mapRules[<CHook *>][<HookType_t>] -> [<HookRule_t>, ...]
+extern std::map<CHook *, std::map<HookType_t, HookRuleList> > g_mapRules;
+
 
 //---------------------------------------------------------------------------------
 // Functions
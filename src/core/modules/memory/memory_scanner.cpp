@@ -53,6 +53,33 @@
 extern IVEngineServer* engine;
 
 
+//-----------------------------------------------------------------------------
+// Globals.
+//-----------------------------------------------------------------------------
+ScanStatistics_t g_ScanStatistics = {0, 0, 0, 0, 0.0};
+
+
+//-----------------------------------------------------------------------------
+// Adds the lifetime of the instance to the scan statistics.
+//-----------------------------------------------------------------------------
+class CScanTimer
+{
+public:
+	CScanTimer()
+	{
+		m_flStart = Plat_FloatTime();
+	}
+
+	~CScanTimer()
+	{
+		g_ScanStatistics.m_flTime += Plat_FloatTime() - m_flStart;
+	}
+
+private:
+	double m_flStart;
+};
+
+
 //-----------------------------------------------------------------------------
 // BinaryFile class
 //-----------------------------------------------------------------------------
@@ -88,10 +115,12 @@ CPointer* CBinaryFile::FindSignatureRaw(object oSignature)
 
 		if (i == iLength)
 		{
+			g_ScanStatistics.m_ullScannedBytes += (unsigned long) base - m_ulBase;
 			return new CPointer((unsigned long) base);
 		}
 		base++;
 	}
+	g_ScanStatistics.m_ullScannedBytes += (unsigned long) base - m_ulBase;
 	return new CPointer();
 }
 
@@ -111,6 +140,7 @@ bool CBinaryFile::SearchSigInCache(unsigned char* sigstr, CPointer*& result)
 		if (strcmp((const char *) sig.m_szSignature, (const char *) sigstr) == 0)
 		{
 			PythonLog(4, "Found a cached signature!");
+			g_ScanStatistics.m_uiCacheHits++;
 			result = new CPointer(sig.m_ulAddr);
 			return true;
 		}
@@ -152,7 +182,9 @@ bool CBinaryFile::SearchSigHooked(object oSignature, int iLength, unsigned char*
 	CPointer new_ptr = CPointer(pPtr->m_ulAddr + len(oSignature));
 
 	// Got another match after the first one?
-	CPointer* pNext = new_ptr.SearchBytes(oSignature, (m_ulBase + m_ulSize) - new_ptr.m_ulAddr);
+	unsigned long ulRemaining = (m_ulBase + m_ulSize) - new_ptr.m_ulAddr;
+	g_ScanStatistics.m_ullScannedBytes += ulRemaining;
+	CPointer* pNext = new_ptr.SearchBytes(oSignature, ulRemaining);
 	bool bIsValid = pNext->IsValid();
 	delete pNext;
 
@@ -167,6 +199,9 @@ bool CBinaryFile::SearchSigHooked(object oSignature, int iLength, unsigned char*
 
 CPointer* CBinaryFile::FindSignature(object oSignature)
 {
+	CScanTimer timer;
+	g_ScanStatistics.m_uiSignatures++;
+
 	unsigned char* sigstr = (unsigned char *) PyBytes_AsString(oSignature.ptr());
 	if (!sigstr)
 		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Failed to read the given signature.");
@@ -205,6 +240,9 @@ CPointer* CBinaryFile::FindSignature(object oSignature)
 
 CPointer* CBinaryFile::FindSymbol(char* szSymbol)
 {
+	CScanTimer timer;
+	g_ScanStatistics.m_uiSymbols++;
+
 #ifdef _WIN32
 	void* pAddr = GetProcAddress((HMODULE) m_ulModule, szSymbol);
 	if (!pAddr)
@@ -290,6 +328,7 @@ CPointer* CBinaryFile::FindSymbol(char* szSymbol)
 	symtab = (Elf32_Sym *)(map_base + symtab_hdr->sh_offset);
 	strtab = (const char *)(map_base + strtab_hdr->sh_offset);
 	symbol_count = symtab_hdr->sh_size / symtab_hdr->sh_entsize;
+	g_ScanStatistics.m_ullScannedBytes += symtab_hdr->sh_size;
 
 	/* Iterate symbol table starting from the position we were at last time */
 	for (uint32_t i = 0; i < symbol_count; i++)
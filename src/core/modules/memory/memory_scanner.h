@@ -41,6 +41,21 @@ struct Signature_t
 };
 
 
+//-----------------------------------------------------------------------------
+// Statistics about all signature and symbol lookups.
+//-----------------------------------------------------------------------------
+struct ScanStatistics_t
+{
+	unsigned int		m_uiSignatures;
+	unsigned int		m_uiSymbols;
+	unsigned int		m_uiCacheHits;
+	unsigned long long	m_ullScannedBytes;
+	double				m_flTime;
+};
+
+extern ScanStatistics_t g_ScanStatistics;
+
+
 class CBinaryFile
 {
 public:
@@ -37,6 +37,7 @@
 #include "memory_utilities.h"
 #include "memory_wrap.h"
 #include "memory_rtti.h"
+#include "memory_array.h"
 
 // DynamicHooks
 #include "registers.h"
@@ -46,6 +47,7 @@
 // ============================================================================
 void export_function_info(scope);
 void export_binary_file(scope);
+void export_scan_statistics(scope);
 void export_pointer(scope);
 void export_type_info(scope);
 void export_type_info_iter(scope);
@@ -54,6 +56,8 @@ void export_data_type_t(scope);
 void export_convention_t(scope);
 void export_hook_type_t(scope);
 void export_stack_data(scope);
+void export_hook_filter(scope);
+void export_hook_rule(scope);
 void export_register_t(scope);
 void export_register(scope);
 void export_registers(scope);
@@ -61,6 +65,7 @@ void export_calling_convention(scope);
 void export_functions(scope);
 void export_global_variables(scope);
 void export_protection(scope);
+void export_array_view(scope);
 
 
 // ============================================================================
@@ -72,6 +77,7 @@ DECLARE_SP_MODULE(_memory)
 
 	export_function_info(_memory);
 	export_binary_file(_memory);
+	export_scan_statistics(_memory);
 	export_pointer(_memory);
 	export_type_info(_memory);
 	export_type_info_iter(_memory);
@@ -80,6 +86,8 @@ DECLARE_SP_MODULE(_memory)
 	export_convention_t(_memory);
 	export_hook_type_t(_memory);
 	export_stack_data(_memory);
+	export_hook_filter(_memory);
+	export_hook_rule(_memory);
 	export_register_t(_memory);
 	export_register(_memory);
 	export_registers(_memory);
@@ -87,6 +95,7 @@ DECLARE_SP_MODULE(_memory)
 	export_functions(_memory);
 	export_global_variables(_memory);
 	export_protection(_memory);
+	export_array_view(_memory);
 }
 
 
@@ -161,6 +170,23 @@ void export_binary_file(scope _memory)
 }
 
 
+// ============================================================================
+// >> ScanStatistics_t
+// ============================================================================
+void export_scan_statistics(scope _memory)
+{
+	class_<ScanStatistics_t, boost::noncopyable> ScanStatistics("ScanStatistics", no_init);
+
+	ScanStatistics.def_readonly("signatures", &ScanStatistics_t::m_uiSignatures, "Number of signature lookups.");
+	ScanStatistics.def_readonly("symbols", &ScanStatistics_t::m_uiSymbols, "Number of symbol lookups.");
+	ScanStatistics.def_readonly("cache_hits", &ScanStatistics_t::m_uiCacheHits, "Number of signatures found in the cache.");
+	ScanStatistics.def_readonly("scanned_bytes", &ScanStatistics_t::m_ullScannedBytes, "Number of bytes that have been scanned.");
+	ScanStatistics.def_readonly("time", &ScanStatistics_t::m_flTime, "Seconds spent in signature and symbol lookups.");
+
+	_memory.attr("scan_statistics") = object(ptr(&g_ScanStatistics));
+}
+
+
 // ============================================================================
 // >> CPointer
 // ============================================================================
@@ -448,6 +474,92 @@ void export_type_info_iter(scope _memory)
 }
 
 
+// ============================================================================
+// >> CArrayView
+// ============================================================================
+void export_array_view(scope _memory)
+{
+	class_<CArrayView> ArrayView(
+		"ArrayView",
+		init<object, DataType_t, optional<object, int> >(
+			(arg("ptr"), arg("type"), arg("length")=object(), arg("stride")=0),
+			"Create a typed view of a native array.\n"
+			"\n"
+			":param Pointer ptr:\n"
+			"	The address of the first element.\n"
+			":param DataType type:\n"
+			"	The type of the elements. Strings are not supported.\n"
+			":param int length:\n"
+			"	The number of elements or None if it's unknown.\n"
+			":param int stride:\n"
+			"	The number of bytes between two elements. If 0, the size of the type is used."
+		)
+	);
+
+	ArrayView.def(
+		"__len__",
+		&CArrayView::__len__,
+		"Return the number of elements.\n"
+		"\n"
+		":raise ValueError:\n"
+		"	Raised if the length is unknown."
+	);
+
+	ArrayView.def(
+		"__getitem__",
+		&CArrayView::__getitem__,
+		"Return the element at the given index or a list of the elements in the given slice."
+	);
+
+	ArrayView.def(
+		"__setitem__",
+		&CArrayView::__setitem__,
+		"Set the element at the given index."
+	);
+
+	ArrayView.def(
+		"tolist",
+		&CArrayView::ToList,
+		"Return all elements as a list.\n"
+		"\n"
+		":rtype: list"
+	);
+
+	ArrayView.add_property(
+		"ptr",
+		make_function(&CArrayView::GetPointer, manage_new_object_policy()),
+		"Return the address of the first element.\n"
+		"\n"
+		":rtype: Pointer"
+	);
+
+	ArrayView.add_property(
+		"length",
+		&CArrayView::GetLength,
+		"Return the number of elements or None if it's unknown."
+	);
+
+	ArrayView.add_property(
+		"type",
+		&CArrayView::GetType,
+		"Return the type of the elements.\n"
+		"\n"
+		":rtype: DataType"
+	);
+
+	ArrayView.add_property(
+		"stride",
+		&CArrayView::GetStride,
+		"Return the number of bytes between two elements.\n"
+		"\n"
+		":rtype: int"
+	);
+
+	// Numeric arrays can be used with memoryview()
+	CArrayView::ExportBuffer(ArrayView);
+}
+
+
 // ============================================================================
 // >> CFunction
 // ============================================================================
@@ -487,9 +599,12 @@ void export_function(scope _memory)
 		)
 
 		.def("add_hook",
-			GET_METHOD(void, CFunction, AddHook, HookType_t eType, PyObject*),
-			"Adds a hook callback.",
-			args("hook_type", "callback")
+			GET_METHOD(void, CFunction, AddHook, HookType_t eType, PyObject*, object),
+			"Adds a hook callback.\n\n"
+			":param HookType hook_type: The type of the hook.\n"
+			":param callable callback: The callback to add.\n"
+			":param HookFilter hook_filter: If given, the callback is only called if the filter accepts the first argument.",
+			(arg("hook_type"), arg("callback"), arg("hook_filter")=object())
 		)
 
 		.def("remove_hook",
@@ -498,6 +613,22 @@ void export_function(scope _memory)
 			args("hook_type", "callback")
 		)
 
+		.def("add_hook_rule",
+			&CFunction::AddHookRule,
+			"Adds a rule that is evaluated before the hook callbacks.\n\n"
+			":param HookType hook_type: The type of the hook.\n"
+			":param HookRule rule: The rule to add. Its conditions can't be changed afterwards.\n"
+			":raise IndexError: If the rule uses an argument the function doesn't have.\n"
+			":raise TypeError: If the value of the rule doesn't match the return or argument type.",
+			args("hook_type", "rule")
+		)
+
+		.def("remove_hook_rule",
+			&CFunction::RemoveHookRule,
+			"Removes a hook rule.",
+			args("hook_type", "rule")
+		)
+
 		.def("add_pre_hook",
 			&CFunction::AddPreHook,
 			"Adds a pre-hook callback."
@@ -644,6 +775,133 @@ void export_stack_data(scope _memory)
 }
 
 
+// ============================================================================
+// >> CHookFilter
+// ============================================================================
+void export_hook_filter(scope _memory)
+{
+	class_<CHookFilter, boost::noncopyable> HookFilter("HookFilter",
+		init<object, object, object, object>(
+			(arg("indexes")=object(), arg("classnames")=object(), arg("vtable")=object(), arg("datamaps")=object()),
+			"Create a filter that is tested against the \"this\" pointer of a hooked entity function.\n\n"
+			":param iterable indexes: Entity indexes to accept.\n"
+			":param iterable classnames: Entity classnames to accept.\n"
+			":param Pointer vtable: The virtual function table to accept.\n"
+			":param iterable datamaps: Datamap class names (e.g. ``CBasePlayer``) to accept. Derived classes are accepted as well.\n\n"
+			"All given predicates must match.\n\n"
+			".. note::\n\n"
+			"    Only use filters with functions that are called on entities."
+		)
+	);
+
+	HookFilter.def("test",
+		&CHookFilter::TestPointer,
+		"Return True if the given pointer is accepted by the filter.",
+		args("pointer")
+	);
+
+	HookFilter.def("add_index",
+		&CHookFilter::AddIndex,
+		"Accept the given entity index.",
+		args("index")
+	);
+
+	HookFilter.def("remove_index",
+		&CHookFilter::RemoveIndex,
+		"Stop accepting the given entity index.",
+		args("index")
+	);
+
+	HookFilter.def("__contains__",
+		&CHookFilter::HasIndex,
+		"Return True if the given entity index is accepted.",
+		args("index")
+	);
+}
+
+
+// ============================================================================
+// >> CHookRule
+// ============================================================================
+void export_hook_rule(scope _memory)
+{
+	enum_<HookRuleOperator_t>("HookRuleOperator")
+		.value("EQUAL", RULE_OPERATOR_EQUAL)
+		.value("NOT_EQUAL", RULE_OPERATOR_NOT_EQUAL)
+		.value("LESS", RULE_OPERATOR_LESS)
+		.value("LESS_EQUAL", RULE_OPERATOR_LESS_EQUAL)
+		.value("GREATER", RULE_OPERATOR_GREATER)
+		.value("GREATER_EQUAL", RULE_OPERATOR_GREATER_EQUAL)
+		.value("IN", RULE_OPERATOR_IN)
+		.value("NOT_IN", RULE_OPERATOR_NOT_IN)
+	;
+
+	enum_<HookRuleAction_t>("HookRuleAction")
+		.value("RETURN", RULE_ACTION_RETURN)
+		.value("SET_ARGUMENT", RULE_ACTION_SET_ARGUMENT)
+		.value("SKIP_CALLBACKS", RULE_ACTION_SKIP_CALLBACKS)
+	;
+
+	class_<CHookRule, boost::noncopyable> HookRule("HookRule",
+		init<HookRuleAction_t, object, int>(
+			(arg("action"), arg("value")=object(), arg("argument")=-1),
+			"Create a rule that is evaluated natively before the hook callbacks.\n\n"
+			":param HookRuleAction action: What to do if all conditions match.\n"
+			":param value: The return value or the new argument value.\n"
+			":param int argument: The argument to set for ``HookRuleAction.SET_ARGUMENT``."
+		)
+	);
+
+	HookRule.def("add_condition",
+		&CHookRule::AddCondition,
+		"Add a condition. All conditions of a rule must match.\n\n"
+		":param int argument: Index of the argument to compare.\n"
+		":param HookRuleOperator operator: The comparison operator.\n"
+		":param value: The value to compare with. An iterable for ``IN`` and ``NOT_IN``.\n"
+		":param int offset: If given, the argument is a pointer and the compared value is read at this offset.\n"
+		":param DataType type: Type of the value at the offset. Defaults to the type of the argument.\n"
+		":param bool entity_index: If True, the pointer is converted to an entity index before it's compared.\n"
+		":raise RuntimeError: If the rule has been added to a function.",
+		(arg("argument"), arg("operator"), arg("value"), arg("offset")=-1, arg("type")=object(), arg("entity_index")=false)
+	);
+
+	HookRule.def("clear_conditions",
+		&CHookRule::ClearConditions,
+		"Remove all conditions.\n\n"
+		":raise RuntimeError: If the rule has been added to a function."
+	);
+
+	HookRule.add_property("action",
+		&CHookRule::GetAction,
+		"Return the action of the rule.\n\n"
+		":rtype: HookRuleAction"
+	);
+
+	HookRule.add_property("value",
+		&CHookRule::GetValue,
+		"Return the value that is set by the action."
+	);
+
+	HookRule.add_property("argument",
+		&CHookRule::GetArgument,
+		"Return the argument that is set by the action.\n\n"
+		":rtype: int"
+	);
+
+	HookRule.add_property("registered",
+		&CHookRule::IsRegistered,
+		"Return whether the rule has been added to a function. Conditions can't be changed while it is.\n\n"
+		":rtype: bool"
+	);
+
+	HookRule.add_property("condition_count",
+		&CHookRule::GetConditionCount,
+		"Return the number of conditions.\n\n"
+		":rtype: int"
+	);
+}
+
+
 // ============================================================================
 // >> Register_t
 // ============================================================================
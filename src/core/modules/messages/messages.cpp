@@ -96,6 +96,76 @@ bool CUserMessage::IsProtobuf()
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// CUserMessageData.
+//-----------------------------------------------------------------------------
+CUserMessageData::CUserMessageData(const char* message_name):
+	m_message_name(message_name)
+{
+	m_index = ::GetMessageIndex(message_name);
+
+#ifdef USE_PROTOBUF
+	const google::protobuf::Message* message = protobuf_helpers.GetPrototype(message_name);
+	if (!message) {
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "Invalid message name: '%s'.", message_name);
+	}
+
+	m_buffer = message->New();
+#else
+	if (m_index == -1) {
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "Invalid message name: '%s'.", message_name);
+	}
+
+	// The data is written into our own buffer, so it can be copied into the
+	// engine's buffer each time the message is sent
+	m_buffer = new bf_write(m_data, sizeof(m_data));
+#endif
+}
+
+CUserMessageData::~CUserMessageData()
+{
+	delete m_buffer;
+}
+
+int CUserMessageData::GetSize()
+{
+#ifdef USE_PROTOBUF
+	return m_buffer->ByteSize();
+#else
+	return m_buffer->GetNumBytesWritten();
+#endif
+}
+
+bool CUserMessageData::IsOverflowed()
+{
+#ifdef USE_PROTOBUF
+	return false;
+#else
+	return m_buffer->IsOverflowed();
+#endif
+}
+
+void CUserMessageData::Send(IRecipientFilter& recipients)
+{
+#ifdef USE_PROTOBUF
+	engine->SendUserMessage(recipients, m_index, *m_buffer);
+#else
+	if (IsOverflowed()) {
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "The data of user message '%s' has overflowed.", GetMessageName());
+	}
+
+	#if defined(ENGINE_LEFT4DEAD2) || defined(ENGINE_BLADE)
+		bf_write* buffer = engine->UserMessageBegin(&recipients, m_index, GetMessageName());
+	#else
+		bf_write* buffer = engine->UserMessageBegin(&recipients, m_index);
+	#endif
+
+	buffer->WriteBits(m_buffer->GetData(), m_buffer->GetNumBitsWritten());
+	engine->MessageEnd();
+#endif
+}
+
+
 //-----------------------------------------------------------------------------
 // Functions.
 //-----------------------------------------------------------------------------
@@ -156,3 +226,54 @@ object GetMessageSize(int index)
 	return object(size);
 #endif
 }
+
+void SendShowMenu(IRecipientFilter& recipients, int valid_slots, int display_time, const char* menu_string, int chunk_size)
+{
+	int index = ::GetMessageIndex("ShowMenu");
+	if (index == -1) {
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "Invalid message name: 'ShowMenu'.");
+	}
+
+#ifdef USE_PROTOBUF
+	const google::protobuf::Message* prototype = protobuf_helpers.GetPrototype("ShowMenu");
+	if (!prototype) {
+		BOOST_RAISE_EXCEPTION(PyExc_NameError, "Invalid message name: 'ShowMenu'.");
+	}
+
+	// Freed even if one of the fields can't be set
+	boost::shared_ptr<google::protobuf::Message> message(prototype->New());
+	CProtobufMessageExt::SetInt32(message.get(), "bits_valid_slots", valid_slots);
+	CProtobufMessageExt::SetInt32(message.get(), "display_time", display_time);
+	CProtobufMessageExt::SetString(message.get(), "menu_string", menu_string);
+
+	engine->SendUserMessage(recipients, index, *message);
+#else
+	// The size of a user message is limited, so long menus are sent in
+	// several chunks. The client puts them together again.
+	if (chunk_size <= 0 || chunk_size > USER_MESSAGE_DATA_SIZE - 5) {
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid chunk size: %i.", chunk_size);
+	}
+
+	int length = strlen(menu_string);
+	do
+	{
+		int chunk_length = length < chunk_size ? length : chunk_size;
+
+	#if defined(ENGINE_LEFT4DEAD2) || defined(ENGINE_BLADE)
+		bf_write* buffer = engine->UserMessageBegin(&recipients, index, "ShowMenu");
+	#else
+		bf_write* buffer = engine->UserMessageBegin(&recipients, index);
+	#endif
+
+		buffer->WriteWord(valid_slots);
+		buffer->WriteChar(display_time);
+		buffer->WriteByte(length > chunk_size);
+		buffer->WriteBytes(menu_string, chunk_length);
+		buffer->WriteByte(0);
+		engine->MessageEnd();
+
+		menu_string += chunk_length;
+		length -= chunk_length;
+	} while (length > 0);
+#endif
+}
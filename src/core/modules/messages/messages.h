@@ -403,6 +403,53 @@ private:
 };
 
 
+//-----------------------------------------------------------------------------
+// Maximum size of a bitbuf user message. This matches the engine's limit.
+//-----------------------------------------------------------------------------
+#define USER_MESSAGE_DATA_SIZE 255
+
+// bf_write only uses multiples of 4 bytes, so the buffer is padded like the
+// engine's buffer
+#define USER_MESSAGE_BUFFER_SIZE PAD_NUMBER(USER_MESSAGE_DATA_SIZE, 4)
+
+
+//-----------------------------------------------------------------------------
+// An encoded user message that can be sent several times without being
+// written again.
+//-----------------------------------------------------------------------------
+class CUserMessageData
+{
+public:
+	CUserMessageData(const char* message_name);
+	~CUserMessageData();
+
+public:
+	const char* GetMessageName()
+	{ return m_message_name.c_str(); }
+
+	int GetMessageIndex()
+	{ return m_index; }
+
+	MESSAGE_BUFFER* GetBuffer()
+	{ return m_buffer; }
+
+	int GetSize();
+	bool IsOverflowed();
+
+	void Send(IRecipientFilter& recipients);
+
+private:
+	std::string m_message_name;
+	int m_index;
+	MESSAGE_BUFFER* m_buffer;
+
+#ifndef USE_PROTOBUF
+	// Unsigned ints, so the buffer is 4 byte aligned
+	unsigned int m_data[USER_MESSAGE_BUFFER_SIZE / 4];
+#endif
+};
+
+
 //-----------------------------------------------------------------------------
 // Functions.
 //-----------------------------------------------------------------------------
@@ -410,5 +457,6 @@ void	CreateMessage( edict_t *pEdict, DIALOG_TYPE type, KeyValues *data );
 int		GetMessageIndex(const char* name);
 object	GetMessageName(int index);
 object	GetMessageSize(int index);
+void	SendShowMenu(IRecipientFilter& recipients, int valid_slots, int display_time, const char* menu_string, int chunk_size);
 
 #endif // _MESSAGES_H
@@ -42,6 +42,7 @@ using namespace boost::python;
 void export_message_functions(scope);
 void export_dialog_enum(scope);
 void export_user_message(scope);
+void export_user_message_data(scope);
 void export_protobuf_message(scope);
 void export_shake_command(scope);
 void export_hud_destination(scope);
@@ -53,6 +54,7 @@ DECLARE_SP_MODULE(_messages)
 	export_message_functions(_messages);
 	export_dialog_enum(_messages);
 	export_user_message(_messages);
+	export_user_message_data(_messages);
 	export_protobuf_message(_messages);
 	export_shake_command(_messages);
 	export_hud_destination(_messages);
@@ -96,6 +98,64 @@ void export_user_message(scope _message)
 }
 
 
+//-----------------------------------------------------------------------------
+// Exposes the UserMessageData class
+//-----------------------------------------------------------------------------
+void export_user_message_data(scope _message)
+{
+	class_<CUserMessageData, boost::noncopyable> UserMessageData(
+		"UserMessageData",
+		"An encoded user message that can be sent several times without being written again.",
+		init<const char*>(
+			(arg("message_name")),
+			"Initialize the object.\n\n"
+			":param str message_name:\n"
+			"	Name of the user message.\n"
+			":raise NameError:\n"
+			"	Raised if the user message does not exist."
+		)
+	);
+
+	UserMessageData.add_property("message_name",
+		&CUserMessageData::GetMessageName
+	);
+
+	UserMessageData.add_property("message_index",
+		&CUserMessageData::GetMessageIndex
+	);
+
+	UserMessageData.add_property("buffer",
+		make_function(&CUserMessageData::GetBuffer, reference_existing_object_policy()),
+		"Return the buffer the user message is written to.\n\n"
+		":rtype: BitBufferWrite/ProtobufMessage"
+	);
+
+	UserMessageData.add_property("size",
+		&CUserMessageData::GetSize,
+		"Return the number of bytes that have been written.\n\n"
+		":rtype: int"
+	);
+
+	UserMessageData.add_property("overflowed",
+		&CUserMessageData::IsOverflowed,
+		"Return True if the data didn't fit into the buffer.\n\n"
+		":rtype: bool"
+	);
+
+	UserMessageData.def("send",
+		&CUserMessageData::Send,
+		"Send the written data to the given recipients.\n\n"
+		":param RecipientFilter recipients:\n"
+		"	The players to send the user message to.\n"
+		":raise ValueError:\n"
+		"	Raised if the data has overflowed.",
+		args("recipients")
+	);
+
+	UserMessageData ADD_MEM_TOOLS(CUserMessageData);
+}
+
+
 //-----------------------------------------------------------------------------
 // Exposes CProtobufMessage
 //-----------------------------------------------------------------------------
@@ -235,6 +295,13 @@ void export_message_functions(scope _messages)
 		"Return the size of the user message. Return None if the user message wasn't found.",
 		args("index")
 	);
+
+	def("send_show_menu",
+		&SendShowMenu,
+		"Send a ShowMenu user message. If the game uses bitbuf user messages, the menu string is "
+		"sent in several parts of ``chunk_size`` bytes.",
+		args("recipients", "valid_slots", "display_time", "menu_string", "chunk_size")
+	);
 }
 
 
@@ -29,6 +29,8 @@
 //-----------------------------------------------------------------------------
 #include "ivoiceserver.h"
 #include "export_main.h"
+#include "players_voice.h"
+#include "modules/memory/memory_function.h"
 #include "modules/memory/memory_utilities.h"
 
 
@@ -38,10 +40,17 @@
 extern IVoiceServer* voiceserver;
 
 
+//-----------------------------------------------------------------------------
+// Global variables.
+//-----------------------------------------------------------------------------
+CMuteMatrix g_MuteMatrix;
+
+
 //-----------------------------------------------------------------------------
 // Forward declarations.
 //-----------------------------------------------------------------------------
 void export_voice_server(scope);
+void export_mute_functions(scope);
 
 
 //-----------------------------------------------------------------------------
@@ -50,6 +59,91 @@ void export_voice_server(scope);
 DECLARE_SP_SUBMODULE(_players, _voice)
 {
 	export_voice_server(_voice);
+	export_mute_functions(_voice);
+}
+
+
+//-----------------------------------------------------------------------------
+// IVoiceServer::SetClientListening hook.
+//-----------------------------------------------------------------------------
+bool PreSetClientListening(HookType_t eHookType, CHook* pHook)
+{
+	int iReceiver = pHook->GetArgument<int>(1);
+	int iSender = pHook->GetArgument<int>(2);
+
+	if (CRecipientBits::IsValidBit(iReceiver) && CRecipientBits::IsValidBit(iSender)
+		&& g_MuteMatrix.IsMutedFast(iSender, iReceiver))
+	{
+		pHook->SetArgument<bool>(3, false);
+	}
+
+	return false;
+}
+
+
+//-----------------------------------------------------------------------------
+// CMuteMatrix.
+//-----------------------------------------------------------------------------
+CMuteMatrix::CMuteMatrix()
+{
+	m_bHooked = false;
+}
+
+void CMuteMatrix::Mute(int iSender, int iReceiver)
+{
+	Validate(iSender, iReceiver);
+
+	// Nobody is muted until the first mute, so don't hook before
+	HookSetClientListening();
+	m_Receivers[iReceiver].Set(iSender);
+}
+
+void CMuteMatrix::Unmute(int iSender, int iReceiver)
+{
+	Validate(iSender, iReceiver);
+	m_Receivers[iReceiver].Clear(iSender);
+}
+
+bool CMuteMatrix::IsMuted(int iSender, int iReceiver)
+{
+	Validate(iSender, iReceiver);
+	return IsMutedFast(iSender, iReceiver);
+}
+
+void CMuteMatrix::UnmuteSender(int iSender)
+{
+	if (!CRecipientBits::IsValidBit(iSender))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid sender: %i.", iSender)
+
+	for (int i=0; i < RECIPIENT_BITS; i++)
+		m_Receivers[i].Clear(iSender);
+}
+
+void CMuteMatrix::Validate(int iSender, int iReceiver)
+{
+	if (!CRecipientBits::IsValidBit(iSender))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid sender: %i.", iSender)
+
+	if (!CRecipientBits::IsValidBit(iReceiver))
+		BOOST_RAISE_EXCEPTION(PyExc_ValueError, "Invalid receiver: %i.", iReceiver)
+}
+
+void CMuteMatrix::HookSetClientListening()
+{
+	if (m_bHooked)
+		return;
+
+	CFunctionInfo* pInfo = GetFunctionInfo(&IVoiceServer::SetClientListening);
+	CFunction* pFunc = CPointer((unsigned long) voiceserver).MakeVirtualFunction(*pInfo);
+	bool bHooked = pFunc->AddHook(HOOKTYPE_PRE, (HookHandlerFn*) (void*) &PreSetClientListening);
+
+	delete pFunc;
+	delete pInfo;
+
+	if (!bHooked)
+		BOOST_RAISE_EXCEPTION(PyExc_RuntimeError, "Could not create a hook for IVoiceServer::SetClientListening.")
+
+	m_bHooked = true;
 }
 
 
@@ -73,4 +167,47 @@ void export_voice_server(scope _voice)
 		FUNCTION_INFO(SetClientListening)
 		FUNCTION_INFO(SetClientProximity)
 	END_CLASS_INFO()
-}
\ No newline at end of file
+}
+
+
+//-----------------------------------------------------------------------------
+// Exports the mute functions.
+//-----------------------------------------------------------------------------
+void MutePlayer(int iSender, int iReceiver)
+{ g_MuteMatrix.Mute(iSender, iReceiver); }
+
+void UnmutePlayer(int iSender, int iReceiver)
+{ g_MuteMatrix.Unmute(iSender, iReceiver); }
+
+bool IsPlayerMuted(int iSender, int iReceiver)
+{ return g_MuteMatrix.IsMuted(iSender, iReceiver); }
+
+void UnmuteSender(int iSender)
+{ g_MuteMatrix.UnmuteSender(iSender); }
+
+void export_mute_functions(scope _voice)
+{
+	def("mute",
+		&MutePlayer,
+		"Mute the sender for the receiver.",
+		args("sender", "receiver")
+	);
+
+	def("unmute",
+		&UnmutePlayer,
+		"Unmute the sender for the receiver.",
+		args("sender", "receiver")
+	);
+
+	def("is_muted",
+		&IsPlayerMuted,
+		"Return True if the sender is muted for the receiver.",
+		args("sender", "receiver")
+	);
+
+	def("unmute_sender",
+		&UnmuteSender,
+		"Unmute the sender for all receivers.",
+		args("sender")
+	);
+}
@@ -0,0 +1,67 @@
+/**
+* =============================================================================
+* Source Python
+* Copyright (C) 2012-2015 Source Python Development Team.  All rights reserved.
+* =============================================================================
+*
+* This program is free software; you can redistribute it and/or modify it under
+* the terms of the GNU General Public License, version 3.0, as published by the
+* Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but WITHOUT
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+* FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+* As a special exception, the Source Python Team gives you permission
+* to link the code of this program (as well as its derivative works) to
+* "Half-Life 2," the "Source Engine," and any Game MODs that run on software
+* by the Valve Corporation.  You must obey the GNU General Public License in
+* all respects for all other code used.  Additionally, the Source.Python
+* Development Team grants this exception to all derivative works.
+*/
+
+#ifndef _PLAYERS_VOICE_H
+#define _PLAYERS_VOICE_H
+
+//-----------------------------------------------------------------------------
+// Includes.
+//-----------------------------------------------------------------------------
+#include "modules/filters/filters_recipients.h"
+
+
+//-----------------------------------------------------------------------------
+// Stores which senders are muted for which receivers.
+//-----------------------------------------------------------------------------
+class CMuteMatrix
+{
+public:
+	CMuteMatrix();
+
+	void Mute(int iSender, int iReceiver);
+	void Unmute(int iSender, int iReceiver);
+	bool IsMuted(int iSender, int iReceiver);
+
+	// Unmutes the sender for all receivers
+	void UnmuteSender(int iSender);
+
+	// Called for every sender/receiver pair, so it doesn't validate
+	bool IsMutedFast(int iSender, int iReceiver) const
+	{ return m_Receivers[iReceiver].IsBitSet(iSender); }
+
+private:
+	void Validate(int iSender, int iReceiver);
+	void HookSetClientListening();
+
+private:
+	// A bitset of muted senders per receiver
+	CRecipientBits m_Receivers[RECIPIENT_BITS];
+	bool m_bHooked;
+};
+
+extern CMuteMatrix g_MuteMatrix;
+
+#endif // _PLAYERS_VOICE_H
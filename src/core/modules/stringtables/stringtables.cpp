@@ -27,6 +27,7 @@
 //---------------------------------------------------------------------------------
 // Includes.
 //---------------------------------------------------------------------------------
+#include <vector>
 #include "stringtables.h"
 
 //---------------------------------------------------------------------------------
@@ -71,6 +72,54 @@ int INetworkStringTableExt::AddString( INetworkStringTable *pTable, const char *
 	return index;
 }
 
+int INetworkStringTableExt::AddStrings( INetworkStringTable *pTable, object strings, bool string_as_user_data, bool is_server )
+{
+	// Convert all strings before locking the tables, so a conversion error
+	// can't leave them unlocked.
+	list items(strings);
+	int num_items = len(items);
+
+	std::vector<std::string> pending;
+	pending.reserve(num_items);
+
+	// Skip strings that are already in the table or appear more than once
+	// in this batch. The table has its own index, so only the batch needs
+	// to be tracked.
+	StringSet batch;
+	batch.rehash(num_items);
+	for (int i=0; i < num_items; ++i)
+	{
+		std::string string = extract<std::string>(items[i]);
+		if (pTable->FindStringIndex(string.c_str()) != INVALID_STRING_INDEX)
+			continue;
+
+		if (batch.insert(string).second)
+			pending.push_back(string);
+	}
+
+	if (pending.empty())
+		return 0;
+
+	int added = 0;
+	bool locked = engine->LockNetworkStringTables(false);
+	for (std::vector<std::string>::const_iterator it = pending.begin(); it != pending.end(); ++it)
+	{
+		const char* string = it->c_str();
+		int index;
+		if (string_as_user_data)
+			index = pTable->AddString(is_server, string, it->length() + 1, (const void *) string);
+		else
+			index = pTable->AddString(is_server, string);
+
+		if (index == INVALID_STRING_INDEX)
+			break;
+
+		++added;
+	}
+	engine->LockNetworkStringTables(locked);
+	return added;
+}
+
 void INetworkStringTableExt::SetStringIndexUserData( INetworkStringTable *pTable, int string_index, const char *user_data, int length )
 {
 	if (length == -1)
@@ -33,6 +33,13 @@
 #include "utilities/wrap_macros.h"
 #include "networkstringtabledefs.h"
 #include "eiface.h"
+#include "boost/unordered_set.hpp"
+
+
+//-----------------------------------------------------------------------------
+// Typedefs.
+//-----------------------------------------------------------------------------
+typedef boost::unordered_set<std::string> StringSet;
 
 
 //-----------------------------------------------------------------------------
@@ -44,6 +51,7 @@ public:
 	static const char* GetString(INetworkStringTable& table, int index);
 	static bool __contains__( INetworkStringTable *pTable, const char *string );
 	static int AddString( INetworkStringTable *pTable, const char *string, const char *user_data, int length, bool is_server, bool auto_unlock );
+	static int AddStrings( INetworkStringTable *pTable, object strings, bool string_as_user_data, bool is_server );
 	static void SetStringIndexUserData( INetworkStringTable *pTable, int string_index, const char *user_data, int length );
 	static void SetStringUserData( INetworkStringTable *pTable, const char *string, const char *user_data, int length );
 	static const char *GetStringIndexUserData( INetworkStringTable *pTable, int string_index );
@@ -111,6 +111,19 @@ void export_stringtable(scope _stringtables)
 			("string", arg("user_data")=object(), arg("length")=-1, arg("is_server")=true, arg("auto_unlock")=true)
 		)
 		
+		.def("add_strings",
+			&INetworkStringTableExt::AddStrings,
+			"Adds all strings of the given iterable to the table, while the tables are only unlocked once.\n\n"
+			"Strings that are already in the table are skipped. If the table is full,\n"
+			"the remaining strings are not added.\n\n"
+			":param iterable strings: The strings to add.\n"
+			":param bool string_as_user_data: If True, each string is also stored as its own user data.\n"
+			":param bool is_server: Whether the strings are added by the server.\n"
+			":return: The number of strings that have been added.\n"
+			":rtype: int",
+			("strings", arg("string_as_user_data")=false, arg("is_server")=true)
+		)
+		
 		.def("__getitem__",
 			&INetworkStringTableExt::GetString,
 			"Returns the string at the given index.",
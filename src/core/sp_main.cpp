@@ -60,6 +60,9 @@
 #include "utilities/conversions.h"
 #include "modules/entities/entities_entity.h"
 #include "modules/core/core.h"
+#include "modules/core/core_profiler.h"
+#include "modules/core/core_collector.h"
+#include "modules/filters/filters_recipients.h"
 
 #ifdef _WIN32
 	#include "Windows.h"
@@ -444,6 +447,7 @@ const char *CSourcePython::GetPluginDescription( void )
 //-----------------------------------------------------------------------------
 void CSourcePython::LevelInit( char const *pMapName )
 {
+	MRecipientFilter::InvalidatePlayerMasks();
 	CALL_LISTENERS(OnLevelInit, pMapName);
 }
 
@@ -465,7 +469,24 @@ void CSourcePython::ServerActivate( edict_t *pEdictList, int edictCount, int cli
 //-----------------------------------------------------------------------------
 void CSourcePython::GameFrame( bool simulating )
 {
-	CALL_LISTENERS(OnTick);
+	double flFrameStart = Plat_FloatTime();
+
+	// A new frame begins, so check the time spent in the previous one
+	if (g_FrameBudget.EndFrame())
+	{
+		CALL_LISTENERS(OnTickBudgetExceeded,
+			g_FrameBudget.GetLastFrameTime(), g_FrameBudget.GetLastFrameBreakdown());
+	}
+
+	{
+		CFrameBudgetScope frame_scope(FRAME_SUBSYSTEM_TICK);
+		CMetricsTimeScope tick_time(METRIC_TICK_TIME);
+		GET_LISTENER_MANAGER(OnTick, tick_manager);
+		CALL_LISTENERS_WITH_SUBSYSTEM(tick_manager, FRAME_SUBSYSTEM_TICK);
+	}
+
+	// Use the rest of the budget for garbage collections
+	g_TickCollector.OnGameFrame(flFrameStart, gpGlobals->interval_per_tick);
 }
 
 //-----------------------------------------------------------------------------
@@ -474,6 +495,7 @@ void CSourcePython::GameFrame( bool simulating )
 void CSourcePython::LevelShutdown( void ) // !!!!this can get called multiple times per map change
 {
 	CALL_LISTENERS(OnLevelShutdown);
+	g_TickCollector.OnLevelShutdown();
 }
 
 //-----------------------------------------------------------------------------
@@ -481,6 +503,8 @@ void CSourcePython::LevelShutdown( void ) // !!!!this can get called multiple ti
 //-----------------------------------------------------------------------------
 void CSourcePython::ClientActive( edict_t *pEntity )
 {
+	MRecipientFilter::InvalidatePlayerMasks();
+
 	unsigned int iEntityIndex;
 	if (!IndexFromEdict(pEntity, iEntityIndex))
 		return;
@@ -495,8 +519,14 @@ void CSourcePython::ClientDisconnect( edict_t *pEntity )
 {
 	unsigned int iEntityIndex;
 	if (!IndexFromEdict(pEntity, iEntityIndex))
+	{
+		MRecipientFilter::InvalidatePlayerMasks();
 		return;
+	}
 
+	// The player is still valid until the end of the tick, but shouldn't
+	// receive any messages anymore
+	MRecipientFilter::InvalidatePlayerMasks(iEntityIndex);
 	CALL_LISTENERS(OnClientDisconnect, iEntityIndex);
 }
 
@@ -505,6 +535,7 @@ void CSourcePython::ClientDisconnect( edict_t *pEntity )
 //-----------------------------------------------------------------------------
 void CSourcePython::ClientPutInServer( edict_t *pEntity, char const *playername )
 {
+	MRecipientFilter::InvalidatePlayerMasks();
 	CALL_LISTENERS(OnClientPutInServer, ptr(pEntity), playername);
 }
 
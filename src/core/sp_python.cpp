@@ -35,8 +35,10 @@
 #include "sp_main.h"
 #include "eiface.h"
 #include "utilities/shared_utils.h"
+#include "utilities/call_python.h"
 #include "export_main.h"
 #include "modules/entities/entities_entity.h"
+#include "modules/core/core_log.h"
 #include "icommandline.h"
 
 
@@ -56,6 +58,7 @@ CPythonManager g_PythonManager;
 // Forward declarations.
 //---------------------------------------------------------------------------------
 void InitConverters();
+void PrintStartupProfile(object profiler);
 
 
 //---------------------------------------------------------------------------------
@@ -118,7 +121,9 @@ bool CPythonManager::Initialize( void )
 	Py_SetPath(wszPythonHome);
 
 	// Initialize python and its namespaces.
+	double flStart = Plat_FloatTime();
 	Py_Initialize();
+	double flPythonTime = Plat_FloatTime() - flStart;
 
 	// Print some information
 	DevMsg(1, MSG_PREFIX "Python version %s initialized!\n", Py_GetVersion());
@@ -172,12 +177,14 @@ bool CPythonManager::Initialize( void )
 	InitConverters();
 
 	// Initialize all submodules
+	flStart = Plat_FloatTime();
 	if (!modulsp_init())
 	{
 		Msg(MSG_PREFIX "Failed to initialize internal modules.\n");
 		PrintCurrentException();
 		return false;
 	}
+	double flModulesTime = Plat_FloatTime() - flStart;
 
 // Patch for issues #175.
 // For unknown reasons the streams might be unable to connect due to io.OpenWrapper failing
@@ -228,7 +235,20 @@ bool CPythonManager::Initialize( void )
 	DevMsg(1, MSG_PREFIX "Loading main module...\n");
 
 	try {
-		python::import("__init__").attr("load")();
+		// The profiler is imported first, so everything else can be profiled
+		object profiler = python::import("core.profiler").attr("startup_profiler");
+		profiler.attr("add")("Py_Initialize", flPythonTime);
+		profiler.attr("add")("internal modules", flModulesTime);
+
+		profiler.attr("begin")("import __init__");
+		object main_module = python::import("__init__");
+		profiler.attr("end")();
+
+		profiler.attr("begin")("load");
+		main_module.attr("load")();
+		profiler.attr("end")();
+
+		PrintStartupProfile(profiler);
 	}
 	catch( ... ) {
 		Msg(MSG_PREFIX "Failed to load the main module due to following exception:\n");
@@ -244,21 +264,49 @@ bool CPythonManager::Initialize( void )
 }
 
 
+//---------------------------------------------------------------------------------
+// Prints how long Source.Python took to load.
+//---------------------------------------------------------------------------------
+void PrintStartupProfile(object profiler)
+{
+	BEGIN_BOOST_PY()
+		PythonLog(3, "Startup profile:");
+
+		list lines = extract<list>(profiler.attr("get_report_lines")());
+		for (int i=0; i < len(lines); i++)
+		{
+			const char* szLine = extract<const char*>(lines[i]);
+			PythonLog(3, "    %s", szLine);
+		}
+
+		object cache = python::import("core").attr("_game_data_cache");
+		PythonLog(3, "    game data cache: %d hit(s), %d miss(es)",
+			(int) extract<int>(cache.attr("hits")),
+			(int) extract<int>(cache.attr("misses")));
+	END_BOOST_PY()
+}
+
+
 //---------------------------------------------------------------------------------
 // Shuts down python.
 //---------------------------------------------------------------------------------
 bool CPythonManager::Shutdown( void )
 {
 	DevMsg(1, MSG_PREFIX "Unloading main module...\n");
+	bool bResult = true;
 	try {
 		python::import("__init__").attr("unload")();
 	}
 	catch( ... ) {
 		Msg(MSG_PREFIX "Failed to unload the main module.\n");
 		PrintCurrentException();
-		return false;
+		bResult = false;
 	}
-	return true;
+
+	// Write all log records that are still queued, even if unloading failed
+	DevMsg(1, MSG_PREFIX "Flushing log files...\n");
+	GetLogSink()->Shutdown();
+	return bResult;
 }
 
 
@@ -35,7 +35,7 @@ Include_Directories(
 # Link libraries.
 # ------------------------------------------------------------------
 Set(SOURCEPYTHON_LINK_LIBRARIES
-    pthread dl util
+    pthread dl util rt
     ${BOOSTSDK_LIB}/libboost_filesystem.a
     ${BOOSTSDK_LIB}/libboost_system.a
 )